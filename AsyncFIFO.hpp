@@ -0,0 +1,339 @@
+/*	=========================================================================
+	Company:
+	Filename: AsyncFIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Thread-safe FIFO with C++20 coroutine awaitables: a
+                    coroutine waiting for an item or for room is suspended
+                    instead of blocking its thread. Requires -std=c++20.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __ASYNCFIFO_HPP__
+#define __ASYNCFIFO_HPP__
+
+#include "FIFO.hpp"
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <coroutine>
+#include <functional>
+#include <utility>
+
+namespace tsFIFO {
+
+    /// Thread-safe FIFO for coroutines.
+    ///
+    /// co_await async_pull() suspends the coroutine until an item comes,
+    /// co_await async_push(item) until there is room (with
+    /// ActionIfFull::Nothing) or until the claimed slot is committed. The
+    /// suspended coroutines are queued in the FIFO as waiter nodes living
+    /// in their own frames, no allocation. Whenever items or room are
+    /// available the oldest waiting coroutines are served, in order, from
+    /// the front of the FIFO. A coroutine is resumed after the mutex is
+    /// released, either inline by the thread that made the item or the
+    /// room available, or by the executor given to the constructor.
+    /// Thousands of coroutines can then wait on a few threads.
+    ///
+    /// push() and pull() work as in FIFO and can be mixed with the
+    /// awaitables, as can claim()/commit(), peek()/release(),
+    /// push_all_or_nothing() and try_pull_bulk(): the waiting coroutines
+    /// are served as soon as each of them releases the mutex.
+    ///
+    /// Example usage:
+    ///
+    ///     tsFIFO::AsyncFIFO<std::unique_ptr<Request>, tsFIFO::ActionIfFull::Nothing> fifo(100,
+    ///         [&pool](std::coroutine_handle<> handle){ pool.post(handle); });
+    ///
+    ///     Task serve(tsFIFO::AsyncFIFO<std::unique_ptr<Request>, tsFIFO::ActionIfFull::Nothing>& fifo) {
+    ///         for(;;) {
+    ///             std::unique_ptr<Request> request = co_await fifo.async_pull();
+    ///             co_await reply(*request);
+    ///         }
+    ///     }
+    ///
+    template<typename T, ActionIfFull action_if_full = ActionIfFull::DumpFirstEntry> class AsyncFIFO
+        : public FIFO<T, action_if_full> {
+
+    public:
+        using Executor = std::function<void(std::coroutine_handle<>)>;
+
+    protected:
+        /// Suspended coroutine, queued as a puller or a pusher, then in the
+        /// list of the coroutines to resume.
+        struct Waiter {
+            std::coroutine_handle<> _handle;
+            Waiter*                 _next;
+        };
+
+        /// Singly-linked list of waiters, the oldest first.
+        struct WaiterList {
+            Waiter* _head;
+            Waiter* _tail;
+
+            WaiterList() : _head(nullptr), _tail(nullptr) {}
+
+            bool empty() const { return _head == nullptr; }
+
+            void push(Waiter* waiter) {
+                waiter->_next = nullptr;
+                if(_tail)
+                    _tail->_next = waiter;
+                else
+                    _head = waiter;
+                _tail = waiter;
+            }
+
+            Waiter* pop() {
+                Waiter* waiter = _head;
+                _head = waiter->_next;
+                if(!_head)
+                    _tail = nullptr;
+                return waiter;
+            }
+        };
+
+    public:
+        /// Awaitable returned by async_pull(), gives the item.
+        class PullAwaiter : protected Waiter {
+
+            friend class AsyncFIFO;
+
+        private:
+            AsyncFIFO*  _fifo;
+            T           _item;
+
+        public:
+            explicit PullAwaiter(AsyncFIFO* fifo) : _fifo(fifo), _item() {}
+
+            bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> handle) {
+                WaiterList ready;
+                {
+                    std::unique_lock<std::mutex> _lock(_fifo->_mutex);
+                    // the coroutines already waiting come first
+                    if(!_fifo->_pullers.empty() || _fifo->is_empty_helper()) {
+                        this->_handle = handle;
+                        _fifo->_pullers.push(this);
+                        return true;
+                    }
+                    _item = _fifo->pull_pop_first();
+                    _fifo->serve_helper(ready, _lock);
+                }
+                _fifo->resume_helper(ready);
+                return false;
+            }
+
+            T await_resume() {
+                return std::move(_item);
+            }
+        };
+
+        /// Awaitable returned by async_push(), gives the status of the push.
+        class PushAwaiter : protected Waiter {
+
+            friend class AsyncFIFO;
+
+        private:
+            AsyncFIFO*  _fifo;
+            T*          _item;
+            Status      _status;
+
+        public:
+            PushAwaiter(AsyncFIFO* fifo, T& item)
+                : _fifo(fifo), _item(&item), _status(Status::SUCCESS) {}
+
+            bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> handle) {
+                WaiterList ready;
+                {
+                    std::unique_lock<std::mutex> _lock(_fifo->_mutex);
+                    // a claimed slot or no room: wait without blocking the thread
+                    if(!_fifo->_pushers.empty() || !_fifo->can_push_helper()) {
+                        this->_handle = handle;
+                        _fifo->_pushers.push(this);
+                        return true;
+                    }
+                    _status = _fifo->push_helper(*_item, _lock);
+                    _fifo->serve_helper(ready, _lock);
+                }
+                _fifo->resume_helper(ready);
+                _fifo->FIFO<T, action_if_full>::dispatch_helper();
+                return false;
+            }
+
+            Status await_resume() const noexcept {
+                return _status;
+            }
+        };
+
+    protected:
+        WaiterList  _pullers;   ///< coroutines waiting for an item
+        WaiterList  _pushers;   ///< coroutines waiting for room or for the commit
+        Executor    _executor;  ///< resumes the coroutines, inline if empty
+
+    public:
+        /// @param size: max number of items
+        /// @param executor: called to resume a coroutine, by default it is resumed inline
+        AsyncFIFO(int size, Executor executor = Executor())
+            : FIFO<T, action_if_full>(size), _executor(std::move(executor)) {}
+        virtual ~AsyncFIFO() {
+            this->clear();
+        }
+
+    public:
+        /// Retrieves an item from the FIFO, for coroutines. (Thread-safe)
+        ///
+        /// co_await gives the oldest item. If the fifo is empty the
+        /// coroutine is suspended until an item is pushed.
+        ///
+        /// @param no param
+        /// @return the awaitable
+        PullAwaiter async_pull() {
+            return PullAwaiter(this);
+        }
+
+        /// Adds an item into the FIFO, for coroutines. (Thread-safe)
+        ///
+        /// co_await gives the status of the push. The coroutine is
+        /// suspended while a slot is claimed, and with ActionIfFull::Nothing
+        /// while the fifo is full; the item must live until it is resumed.
+        /// Otherwise it behaves as push().
+        ///
+        /// @param item: element to push into the fifo
+        /// @return the awaitable
+        PushAwaiter async_push(T& item) {
+            return PushAwaiter(this, item);
+        }
+
+        /// Adds an item into the FIFO. (Thread-safe)
+        ///
+        /// As FIFO::push(), then the oldest coroutines waiting in
+        /// async_pull(), if any, get the items from the front.
+        ///
+        /// @param item: element to push into the fifo
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push(T& item) override {
+            WaiterList ready;
+            Status status;
+            {
+                std::unique_lock<std::mutex> _lock(this->_mutex);
+                status = this->push_helper(item, _lock);
+                serve_helper(ready, _lock);
+            }
+            resume_helper(ready);
+            FIFO<T, action_if_full>::dispatch_helper();
+            return status;
+        }
+
+        /// Retrieves an item from the FIFO. (Thread-safe)
+        ///
+        /// As FIFO::pull(), then the oldest coroutines waiting in
+        /// async_push(), if any, push their items.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @return no return
+        void pull(T& item) override {
+            WaiterList ready;
+            {
+                std::unique_lock<std::mutex> _lock(this->_mutex);
+                while(this->is_empty_helper()) {
+                    this->_condv.wait(_lock);
+                }
+                item = this->pull_pop_first();
+                serve_helper(ready, _lock);
+            }
+            resume_helper(ready);
+            FIFO<T, action_if_full>::dispatch_helper();
+        }
+
+        /// Retrieves an item from the FIFO. (Thread-safe)
+        ///
+        /// As FIFO::pull() with a timeout, then the oldest coroutines
+        /// waiting in async_push(), if any, push their items.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @param timeout: an integer defining the max amount of time to wait for a new item
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status pull(T& item, unsigned timeout) override {
+            WaiterList ready;
+            {
+                std::unique_lock<std::mutex> _lock(this->_mutex);
+                while(this->is_empty_helper()) {
+                    if(this->_condv.wait_for(_lock, std::chrono::milliseconds(timeout))==std::cv_status::timeout)
+                        return Status::TIMEOUT;
+                }
+                item = this->pull_pop_first();
+                serve_helper(ready, _lock);
+            }
+            resume_helper(ready);
+            FIFO<T, action_if_full>::dispatch_helper();
+            return Status::SUCCESS;
+        }
+
+    protected:
+        /// Serves the waiting coroutines after commit(), release(),
+        /// push_all_or_nothing() or try_pull_bulk(), then posts the
+        /// subscribers. The mutex must not be locked.
+        void dispatch_helper() override {
+            WaiterList ready;
+            {
+                std::unique_lock<std::mutex> _lock(this->_mutex);
+                serve_helper(ready, _lock);
+            }
+            resume_helper(ready);
+            FIFO<T, action_if_full>::dispatch_helper();
+        }
+
+        /// Check if a push can be done now, the mutex must be locked.
+        bool can_push_helper() {
+            return !this->_claimed && (action_if_full == ActionIfFull::DumpFirstEntry || !this->is_full_helper());
+        }
+
+        /// Gives the items at the front to the oldest waiting pullers and
+        /// lets the oldest waiting pushers in, as long as possible, the
+        /// mutex must be locked.
+        ///
+        /// @param ready: receives the coroutines to resume, in order
+        /// @param lock: the lock of the mutex
+        /// @return no return
+        void serve_helper(WaiterList& ready, std::unique_lock<std::mutex>& lock) {
+            for(;;) {
+                if(!_pullers.empty() && !this->is_empty_helper()) {
+                    PullAwaiter* consumer = static_cast<PullAwaiter*>(_pullers.pop());
+                    consumer->_item = this->pull_pop_first();
+                    ready.push(consumer);
+                } else if(!_pushers.empty() && can_push_helper()) {
+                    PushAwaiter* producer = static_cast<PushAwaiter*>(_pushers.pop());
+                    producer->_status = this->push_helper(*producer->_item, lock);
+                    ready.push(producer);
+                } else {
+                    return;
+                }
+            }
+        }
+
+        /// Resumes coroutines, the mutex must not be locked.
+        ///
+        /// @param ready: the coroutines, the list is emptied
+        /// @return no return
+        void resume_helper(WaiterList& ready) {
+            while(!ready.empty()) {
+                // the waiter lives in the frame: read it before resuming
+                std::coroutine_handle<> handle = ready.pop()->_handle;
+                if(_executor)
+                    _executor(handle);
+                else
+                    handle.resume();
+            }
+        }
+    };
+};
+
+#endif
+
+#endif
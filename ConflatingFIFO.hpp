@@ -0,0 +1,299 @@
+/*	=========================================================================
+	Company:
+	Filename: ConflatingFIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Thread-safe FIFO keeping only the latest update per key.
+                    A push whose key is already queued replaces the queued
+                    item in place.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __CONFLATINGFIFO_HPP__
+#define __CONFLATINGFIFO_HPP__
+
+#include "FIFO.hpp"
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+namespace tsFIFO {
+
+    /// Thread-safe conflating FIFO.
+    ///
+    /// Every item exposes a key through item->get_key(). When an item is
+    /// pushed while another item with the same key is still queued, the new
+    /// item replaces the old one and keeps its position in the queue. Under
+    /// backlog the consumers process at most one item per distinct key.
+    ///
+    /// The queued items are found by key through an open-addressed hash
+    /// table mapping the key to the position of the item in the queue.
+    ///
+    /// Example usage:
+    ///
+    ///     class Quote {
+    ///         public:
+    ///             std::string _symbol;
+    ///             double _price;
+    ///             const std::string& get_key(){ return _symbol; }
+    ///     };
+    ///
+    ///     tsFIFO::ConflatingFIFO<std::unique_ptr<Quote>> fifo(1000);
+    ///     std::unique_ptr<Quote> quote = std::make_unique<Quote>("ABC", 1.0);
+    ///     fifo.push(quote);
+    ///     quote = std::make_unique<Quote>("ABC", 1.1);
+    ///     fifo.push(quote); // replaces the first one
+    ///     fifo.pull(quote); // 1.1
+    ///
+    template<typename T, ActionIfFull action_if_full = ActionIfFull::DumpFirstEntry> class ConflatingFIFO {
+
+    public:
+        using Key = typename std::decay<decltype(std::declval<T&>()->get_key())>::type;
+
+    protected:
+        struct Bucket {
+            Key      _key;
+            uint64_t _pos;      ///< position of the item in the queue
+            bool     _used;
+        };
+
+        std::deque<T>           _queue;
+        uint64_t                _first_pos;     ///< position of _queue.front()
+        std::vector<Bucket>     _index;
+        size_t                  _index_mask;
+        std::hash<Key>          _hash;
+        int                     _max_size;
+        std::condition_variable _condv;
+        std::mutex              _mutex;
+
+    public:
+        ConflatingFIFO() : _first_pos(0), _max_size(0) {
+            rehash_helper(0);
+        }
+        ConflatingFIFO(int size) : _first_pos(0), _max_size(size) {
+            rehash_helper(size);
+        }
+        virtual ~ConflatingFIFO() {}
+
+    public:
+        /// Adds an item into the FIFO or replaces the queued item with the same key. (Thread-safe)
+        ///
+        /// If the FIFO is full and the key is not queued ActionIfFull defines
+        /// the action to undertake.
+        ///
+        /// @param item: element to push into the fifo
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            const Key& key = item->get_key();
+            size_t bucket = find_helper(key);
+            if(bucket != npos) {
+                // conflation: the new item takes the place of the old one
+                T& queued = _queue[_index[bucket]._pos - _first_pos];
+                T old = std::move(queued);
+                queued = std::move(item);
+                clear_helper(old);
+                return Status::SUCCESS;
+            }
+            if(is_full_helper()) {
+                if(action_if_full == ActionIfFull::DumpFirstEntry && !_queue.empty()) {
+                    T first = pull_pop_first(); // dump the the oldest item
+                    clear_helper(first);
+                    push_last(item); // add the new one
+                }
+                return Status::FULL;
+            }
+            push_last(item);
+            _condv.notify_one();
+            return Status::SUCCESS;
+        }
+
+        /// Retrieves an item from the FIFO. (Thread-safe)
+        ///
+        /// The oldest element in the FIFO is pulled. If the fifo is empty
+        /// this function blocks until new data are available.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @return no return
+        void pull(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(_queue.empty()) {
+                _condv.wait(_lock);
+            }
+            item = pull_pop_first();
+        }
+
+        /// Retrieves an item from the FIFO. (Thread-safe)
+        ///
+        /// The oldest element in the FIFO is pulled. If the fifo is empty
+        /// this function blocks until new data are available or the timeout is reached.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @param timeout: an integer defining the max amount of time to wait for a new item
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status pull(T& item, unsigned timeout) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(_queue.empty()) {
+                if(_condv.wait_for(_lock, std::chrono::milliseconds(timeout))==std::cv_status::timeout)
+                    return Status::TIMEOUT;
+            }
+            item = pull_pop_first();
+            return Status::SUCCESS;
+        }
+
+        /// Returns the current number of items, one per distinct key. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return current number of items in the fifo
+        int size() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _queue.size();
+        }
+
+        /// Sets the max FIFO size. (Thread-safe)
+        ///
+        /// @param size: integer defining the max fifo size
+        /// @return no param
+        void set_max_size(int size) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            _max_size = size;
+            rehash_helper(size);
+        }
+
+        /// Gets the max FIFO size. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return max fifo size
+        int get_max_size() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _max_size;
+        }
+
+        /// Deletes all the items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        void clear() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(!_queue.empty()) {
+                T item = pull_pop_first();
+                // For C-style pointers, clear_helper() calls delete.
+                clear_helper(item);
+            }
+        }
+
+        /// Check if FIFO is full. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        bool is_full() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return is_full_helper();
+        }
+
+    protected:
+        static const size_t npos = static_cast<size_t>(-1);
+
+        /// Gets the first item then pop it and its key
+        ///
+        /// @param no param
+        /// @return the item
+        T pull_pop_first() {
+            T item = std::move(_queue.front());
+            _queue.pop_front();
+            erase_helper(find_helper(item->get_key()));
+            ++_first_pos;
+            return item;
+        }
+
+        /// Add item into the FIFO and index its key
+        ///
+        /// @param item: the item to add
+        /// @return no return
+        void push_last(T& item) {
+            if(2*(_queue.size() + 1) > _index.size())
+                rehash_helper(_queue.size() + 1);
+            size_t bucket = _hash(item->get_key()) & _index_mask;
+            while(_index[bucket]._used)
+                bucket = (bucket + 1) & _index_mask;
+            _index[bucket] = Bucket{item->get_key(), _first_pos + _queue.size(), true};
+            _queue.push_back(std::move(item));
+        }
+
+        /// Check if FIFO is full.
+        ///
+        /// @param no param
+        /// @return no param
+        bool is_full_helper() {
+            return (static_cast<int>(_queue.size()) >= _max_size);
+        }
+
+        /// Linear probing from the home bucket of the key.
+        ///
+        /// @param key: the key to look for
+        /// @return the bucket of the key or npos
+        size_t find_helper(const Key& key) {
+            size_t bucket = _hash(key) & _index_mask;
+            while(_index[bucket]._used) {
+                if(_index[bucket]._key == key)
+                    return bucket;
+                bucket = (bucket + 1) & _index_mask;
+            }
+            return npos;
+        }
+
+        /// Empties a bucket and shifts back the following entries that
+        /// were displaced by it, so that no tombstone is needed.
+        ///
+        /// @param bucket: the bucket to empty
+        /// @return no return
+        void erase_helper(size_t bucket) {
+            size_t hole = bucket;
+            size_t next = bucket;
+            for(;;) {
+                next = (next + 1) & _index_mask;
+                if(!_index[next]._used)
+                    break;
+                size_t home = _hash(_index[next]._key) & _index_mask;
+                // move the entry into the hole if its home is not in (hole, next]
+                if(((next - home) & _index_mask) >= ((next - hole) & _index_mask)) {
+                    _index[hole] = std::move(_index[next]);
+                    hole = next;
+                }
+            }
+            _index[hole]._used = false;
+            _index[hole]._key = Key();
+        }
+
+        /// Resizes the hash table to at least twice the number of items.
+        ///
+        /// @param size: number of items to accommodate
+        /// @return no return
+        void rehash_helper(int size) {
+            size_t needed = 16;
+            size_t count = (size > static_cast<int>(_queue.size())) ? size : _queue.size();
+            while(needed < 2*count)
+                needed <<= 1;
+            if(needed == _index.size())
+                return;
+            _index.assign(needed, Bucket{Key(), 0, false});
+            _index_mask = needed - 1;
+            for(size_t i=0; i<_queue.size(); ++i) {
+                size_t bucket = _hash(_queue[i]->get_key()) & _index_mask;
+                while(_index[bucket]._used)
+                    bucket = (bucket + 1) & _index_mask;
+                _index[bucket] = Bucket{_queue[i]->get_key(), _first_pos + i, true};
+            }
+        }
+    };
+};
+
+#endif
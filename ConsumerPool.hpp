@@ -0,0 +1,245 @@
+/*	=========================================================================
+	Company:
+	Filename: ConsumerPool.hpp
+	Last modifed:   17.10.2026
+	Description:    Pool of consumer threads of a FIFO whose size follows
+                    the load, from the queue depth, the time in queue and
+                    the utilization of the consumers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __CONSUMERPOOL_HPP__
+#define __CONSUMERPOOL_HPP__
+
+#include "FIFO.hpp"
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <limits>
+#include <functional>
+#include <utility>
+
+namespace tsFIFO {
+
+    /// Auto-scaling pool of consumers of a FIFO.
+    ///
+    /// Each worker pulls an item from the fifo and gives it to the handler.
+    /// Every period a controller thread samples the depth of the fifo, the
+    /// number of items handled and the time the workers spent in the
+    /// handler. The time in queue is estimated by Little's law, depth /
+    /// rate, the utilization is the busy time over the time of the active
+    /// workers. Then:
+    ///  - a worker is added when the time in queue is above the target and
+    ///    the workers are busy (utilization > 75%): more threads would help;
+    ///  - a worker is parked when the time in queue is below half the target
+    ///    and the others could take its load staying under 50%, for 3
+    ///    periods in a row.
+    /// The gap between the two thresholds and the 3 periods are the
+    /// hysteresis: the pool does not oscillate around a load. The parked
+    /// workers sleep on the pool, not on the fifo, and are woken before
+    /// any new thread is created. max_workers bounds the contention on the
+    /// fifo (see results.txt for the cost of too many consumers).
+    ///
+    /// An exception thrown by the handler drops the item, see errors(). The
+    /// handler owns the item; C-style pointers are deleted by it. The items
+    /// still in the fifo when the pool is destroyed are left there.
+    ///
+    /// Example usage:
+    ///
+    ///     tsFIFO::FIFO<std::unique_ptr<Request>, tsFIFO::ActionIfFull::Nothing> fifo(1000);
+    ///     tsFIFO::ConsumerPool<std::unique_ptr<Request>, tsFIFO::ActionIfFull::Nothing> pool(fifo,
+    ///         [](std::unique_ptr<Request>& request){ serve(*request); },
+    ///         1, 4, 10); // between 1 and 4 workers, 10ms max in queue
+    ///     fifo.push(request);
+    ///
+    template<typename T, ActionIfFull action_if_full = ActionIfFull::DumpFirstEntry> class ConsumerPool {
+
+    protected:
+        FIFO<T, action_if_full>&        _fifo;
+        std::function<void(T&)>         _handler;
+        int                             _min_workers;
+        int                             _max_workers;
+        double                          _target_sojourn;    ///< [s]
+        unsigned                        _period;            ///< [ms]
+        std::atomic<int>                _workers;           ///< workers allowed to pull, the others are parked
+        std::atomic<int>                _spawned;
+        std::atomic<bool>               _stop;
+        std::atomic<uint64_t>           _processed;
+        std::atomic<uint64_t>           _errors;
+        std::atomic<uint64_t>           _busy;              ///< time spent in the handler [ns]
+        int                             _calm;              ///< periods in a row the pool could shrink
+        double                          _sojourn;           ///< last estimate [s]
+        double                          _utilization;       ///< last estimate
+        std::vector<std::thread>        _threads;
+        std::thread                     _controller;
+        std::condition_variable         _condv_parked;
+        std::condition_variable         _condv_control;
+        std::mutex                      _mutex;
+
+    public:
+        /// @param fifo: the fifo to consume, it must outlive the pool
+        /// @param handler: function handling an item
+        /// @param min_workers: min number of active workers
+        /// @param max_workers: max number of active workers
+        /// @param target_sojourn: max time in queue before adding a worker [ms]
+        /// @param period: time between two samples of the load [ms]
+        ConsumerPool(FIFO<T, action_if_full>& fifo, std::function<void(T&)> handler,
+                     int min_workers, int max_workers, unsigned target_sojourn = 10, unsigned period = 100)
+            : _fifo(fifo), _handler(std::move(handler)),
+              _min_workers(min_workers > 0 ? min_workers : 1),
+              _max_workers(max_workers > _min_workers ? max_workers : _min_workers),
+              _target_sojourn(target_sojourn / 1000.0), _period(period > 0 ? period : 1),
+              _workers(_min_workers), _spawned(0), _stop(false), _processed(0), _errors(0), _busy(0),
+              _calm(0), _sojourn(0.0), _utilization(0.0) {
+            _threads.reserve(_max_workers);
+            for(int i=0; i<_min_workers; ++i)
+                spawn_helper();
+            _controller = std::thread(&ConsumerPool::controller, this);
+        }
+        virtual ~ConsumerPool() {
+            {
+                std::unique_lock<std::mutex> _lock(_mutex);
+                _stop.store(true);
+                _condv_parked.notify_all();
+                _condv_control.notify_all();
+            }
+            _controller.join();
+            // the active workers see _stop after at most a period in pull()
+            for(std::thread& thread : _threads)
+                thread.join();
+        }
+        ConsumerPool(const ConsumerPool&) = delete;
+        ConsumerPool& operator=(const ConsumerPool&) = delete;
+
+    public:
+        /// Number of active workers. (Thread-safe)
+        int workers() {
+            return _workers.load();
+        }
+
+        /// Number of parked workers. (Thread-safe)
+        int parked() {
+            int parked = _spawned.load() - _workers.load();
+            return parked > 0 ? parked : 0;
+        }
+
+        /// Number of items handled. (Thread-safe)
+        uint64_t processed() {
+            return _processed.load();
+        }
+
+        /// Number of items whose handler threw. (Thread-safe)
+        uint64_t errors() {
+            return _errors.load();
+        }
+
+        /// Last estimate of the time in queue [ms]. (Thread-safe)
+        double sojourn() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _sojourn * 1000.0;
+        }
+
+        /// Last estimate of the utilization of the active workers, in [0,1]. (Thread-safe)
+        double utilization() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _utilization;
+        }
+
+    protected:
+        void worker(int index) {
+            T item;
+            while(!_stop.load()) {
+                if(index >= _workers.load()) {
+                    std::unique_lock<std::mutex> _lock(_mutex);
+                    while(index >= _workers.load() && !_stop.load())
+                        _condv_parked.wait(_lock);
+                    continue;
+                }
+                if(_fifo.pull(item, _period) == Status::TIMEOUT)
+                    continue;
+                auto start = std::chrono::steady_clock::now();
+                try {
+                    _handler(item);
+                } catch(...) {
+                    _errors.fetch_add(1, std::memory_order_relaxed);
+                }
+                _busy.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+                _processed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void controller() {
+            auto last = std::chrono::steady_clock::now();
+            uint64_t last_processed = 0;
+            uint64_t last_busy = 0;
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(!_stop.load()) {
+                _condv_control.wait_for(_lock, std::chrono::milliseconds(_period));
+                if(_stop.load())
+                    break;
+                auto now = std::chrono::steady_clock::now();
+                uint64_t processed = _processed.load();
+                uint64_t busy = _busy.load();
+                adjust_helper(_fifo.size(), processed - last_processed, (busy - last_busy) / 1e9,
+                              std::chrono::duration<double>(now - last).count());
+                last = now;
+                last_processed = processed;
+                last_busy = busy;
+            }
+        }
+
+        /// Adds or parks a worker from a sample of the load, the mutex must be locked.
+        ///
+        /// @param depth: items in the fifo
+        /// @param processed: items handled during the sample
+        /// @param busy: time spent in the handler during the sample [s]
+        /// @param elapsed: duration of the sample [s]
+        /// @return no return
+        void adjust_helper(int depth, uint64_t processed, double busy, double elapsed) {
+            if(elapsed <= 0)
+                return;
+            int workers = _workers.load();
+            double rate = processed / elapsed;
+            _sojourn = rate > 0 ? depth / rate : (depth > 0 ? std::numeric_limits<double>::infinity() : 0.0);
+            _utilization = busy / (elapsed * workers);
+            if(_utilization > 1.0)
+                _utilization = 1.0;
+
+            if(_sojourn > _target_sojourn && _utilization > 0.75) {
+                _calm = 0;
+                if(workers < _max_workers) {
+                    _workers.store(workers + 1);
+                    // a parked worker first, a new thread otherwise
+                    if(_spawned.load() <= workers)
+                        spawn_helper();
+                    else
+                        _condv_parked.notify_all();
+                }
+            } else if(_sojourn <= _target_sojourn / 2 && workers > _min_workers
+                      && _utilization * workers < 0.5 * (workers - 1)) {
+                if(++_calm >= 3) {
+                    _calm = 0;
+                    _workers.store(workers - 1);
+                }
+            } else {
+                _calm = 0;
+            }
+        }
+
+        void spawn_helper() {
+            int index = _spawned.load();
+            _threads.emplace_back(&ConsumerPool::worker, this, index);
+            _spawned.store(index + 1);
+        }
+    };
+};
+
+#endif
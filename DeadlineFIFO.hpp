@@ -0,0 +1,293 @@
+/*	=========================================================================
+	Company:
+	Filename: DeadlineFIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Thread-safe queue serving the items by earliest deadline
+                    first. The items whose deadline has passed are dropped.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __DEADLINEFIFO_HPP__
+#define __DEADLINEFIFO_HPP__
+
+#include "FIFO.hpp"
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <chrono>
+#include <utility>
+#include <type_traits>
+
+namespace tsFIFO {
+
+    /// Thread-safe earliest-deadline-first queue.
+    ///
+    /// Every item exposes its deadline, a std::chrono::time_point, through
+    /// item->get_deadline(). pull() returns the item with the earliest
+    /// deadline, the items with the same deadline in the order they were
+    /// pushed. Before that, all the items at the head whose deadline has
+    /// already passed are dropped at once: they are never handed to a
+    /// consumer.
+    ///
+    /// The items are kept in a 4-ary heap: half the depth of a binary
+    /// heap, and the four children of a node are contiguous in memory.
+    ///
+    /// Example usage:
+    ///
+    ///     class Request {
+    ///         public:
+    ///             std::chrono::steady_clock::time_point _deadline;
+    ///             std::chrono::steady_clock::time_point get_deadline(){ return _deadline; }
+    ///     };
+    ///
+    ///     tsFIFO::DeadlineFIFO<std::unique_ptr<Request>> fifo(100);
+    ///     fifo.push(request);
+    ///     fifo.pull(request); // earliest deadline, not expired
+    ///     uint64_t missed = fifo.get_expired();
+    ///
+    template<typename T, ActionIfFull action_if_full = ActionIfFull::DumpFirstEntry> class DeadlineFIFO {
+
+    public:
+        using Deadline = typename std::decay<decltype(std::declval<T&>()->get_deadline())>::type;
+        using Clock = typename Deadline::clock;
+
+    protected:
+        static const size_t D = 4; ///< arity of the heap
+
+        struct Node {
+            Deadline    _deadline;
+            uint64_t    _seq;       ///< push order, for the ties
+            T           _item;
+        };
+
+        std::vector<Node>       _heap;
+        uint64_t                _seq;
+        uint64_t                _expired;   ///< items dropped past their deadline
+        int                     _max_size;
+        std::condition_variable _condv;
+        std::mutex              _mutex;
+
+    public:
+        DeadlineFIFO() : _seq(0), _expired(0), _max_size(0) {}
+        DeadlineFIFO(int size) : _seq(0), _expired(0), _max_size(size) {
+            _heap.reserve(size);
+        }
+        virtual ~DeadlineFIFO() {
+            clear();
+        }
+
+    public:
+        /// Adds an item into the FIFO. (Thread-safe)
+        ///
+        /// If the FIFO is full the expired items are dropped first. If it
+        /// is still full ActionIfFull defines the action to undertake:
+        /// DumpFirstEntry dumps the item with the earliest deadline.
+        ///
+        /// @param item: element to push into the fifo
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            if(is_full_helper())
+                drop_expired_helper(Clock::now());
+            if(is_full_helper()) {
+                if(action_if_full == ActionIfFull::DumpFirstEntry && !_heap.empty()) {
+                    T first = pop_first(); // dump the most urgent item
+                    clear_helper(first);
+                    push_last(item); // add the new one
+                }
+                return Status::FULL;
+            }
+            push_last(item);
+            _condv.notify_one();
+            return Status::SUCCESS;
+        }
+
+        /// Retrieves an item from the FIFO. (Thread-safe)
+        ///
+        /// The item with the earliest deadline not passed yet is pulled. If
+        /// the fifo is empty this function blocks until new data are available.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @return no return
+        void pull(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            for(;;) {
+                drop_expired_helper(Clock::now());
+                if(!_heap.empty())
+                    break;
+                _condv.wait(_lock);
+            }
+            item = pop_first();
+        }
+
+        /// Retrieves an item from the FIFO. (Thread-safe)
+        ///
+        /// The item with the earliest deadline not passed yet is pulled. If
+        /// the fifo is empty this function blocks until new data are available
+        /// or the timeout is reached.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @param timeout: an integer defining the max amount of time to wait for a new item
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status pull(T& item, unsigned timeout) {
+            auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+            std::unique_lock<std::mutex> _lock(_mutex);
+            for(;;) {
+                drop_expired_helper(Clock::now());
+                if(!_heap.empty())
+                    break;
+                if(_condv.wait_until(_lock, until)==std::cv_status::timeout)
+                    return Status::TIMEOUT;
+            }
+            item = pop_first();
+            return Status::SUCCESS;
+        }
+
+        /// Returns the current number of items, expired ones included. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return current number of items in the fifo
+        int size() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _heap.size();
+        }
+
+        /// Returns the number of items dropped past their deadline. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return number of expired items since the creation of the fifo
+        uint64_t get_expired() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _expired;
+        }
+
+        /// Sets the max FIFO size. (Thread-safe)
+        ///
+        /// @param size: integer defining the max fifo size
+        /// @return no param
+        void set_max_size(int size) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            _max_size = size;
+        }
+
+        /// Gets the max FIFO size. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return max fifo size
+        int get_max_size() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _max_size;
+        }
+
+        /// Deletes all the items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        void clear() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            for(Node& node : _heap) {
+                // For C-style pointers, clear_helper() calls delete.
+                clear_helper(node._item);
+            }
+            _heap.clear();
+        }
+
+        /// Check if FIFO is full. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        bool is_full() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return is_full_helper();
+        }
+
+    protected:
+        /// Drops all the items at the head whose deadline is before now.
+        ///
+        /// @param now: the current time
+        /// @return no return
+        void drop_expired_helper(const Deadline& now) {
+            while(!_heap.empty() && _heap.front()._deadline < now) {
+                T item = pop_first();
+                clear_helper(item);
+                ++_expired;
+            }
+        }
+
+        /// Gets the item with the earliest deadline then pop it
+        ///
+        /// @param no param
+        /// @return the item
+        T pop_first() {
+            T item = std::move(_heap.front()._item);
+            if(_heap.size() > 1) {
+                _heap.front() = std::move(_heap.back());
+                _heap.pop_back();
+                sift_down(0);
+            } else {
+                _heap.pop_back();
+            }
+            return item;
+        }
+
+        /// Add item into the heap
+        ///
+        /// @param item: the item to add
+        /// @return no return
+        void push_last(T& item) {
+            Deadline deadline = item->get_deadline();
+            _heap.push_back(Node{deadline, _seq++, std::move(item)});
+            sift_up(_heap.size() - 1);
+        }
+
+        static bool before(const Node& a, const Node& b) {
+            return a._deadline < b._deadline || (a._deadline == b._deadline && a._seq < b._seq);
+        }
+
+        void sift_up(size_t i) {
+            Node node = std::move(_heap[i]);
+            while(i > 0) {
+                size_t parent = (i - 1) / D;
+                if(!before(node, _heap[parent]))
+                    break;
+                _heap[i] = std::move(_heap[parent]);
+                i = parent;
+            }
+            _heap[i] = std::move(node);
+        }
+
+        void sift_down(size_t i) {
+            const size_t n = _heap.size();
+            Node node = std::move(_heap[i]);
+            for(;;) {
+                size_t first = D*i + 1;
+                if(first >= n)
+                    break;
+                size_t last = (first + D < n) ? first + D : n;
+                size_t best = first;
+                for(size_t c=first+1; c<last; ++c)
+                    if(before(_heap[c], _heap[best]))
+                        best = c;
+                if(!before(_heap[best], node))
+                    break;
+                _heap[i] = std::move(_heap[best]);
+                i = best;
+            }
+            _heap[i] = std::move(node);
+        }
+
+        /// Check if FIFO is full.
+        ///
+        /// @param no param
+        /// @return no param
+        bool is_full_helper() {
+            return (static_cast<int>(_heap.size()) >= _max_size);
+        }
+    };
+};
+
+#endif
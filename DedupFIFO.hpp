@@ -0,0 +1,239 @@
+/*	=========================================================================
+	Company:
+	Filename: DedupFIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Thread-safe FIFO rejecting the items whose id has been
+                    pushed recently. The ids are remembered in a rotating
+                    Bloom filter covering a window of pushes and/or time.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __DEDUPFIFO_HPP__
+#define __DEDUPFIFO_HPP__
+
+#include "FIFO.hpp"
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <type_traits>
+
+namespace tsFIFO {
+
+    /// Set of the ids seen in a sliding window, probabilistic.
+    ///
+    /// Two Bloom filters are used in turn: the ids are added to the current
+    /// one and looked up in both. When the current filter has received
+    /// `window` ids, or is older than `period`, it becomes the previous one
+    /// and the old previous one is cleared. Any id added within the last
+    /// `window` additions (and the last `period`) is found; older ids are
+    /// forgotten after at most twice that. An id never added can be
+    /// reported as seen with probability false_positive_rate.
+    class BloomWindow {
+
+    private:
+        std::vector<uint64_t> _bits[2];
+        size_t   _current;
+        size_t   _nbits;
+        unsigned _nhashes;
+        size_t   _window;
+        size_t   _count;        ///< ids added to the current filter
+        std::chrono::steady_clock::duration     _period;
+        std::chrono::steady_clock::time_point   _rotated;
+
+    public:
+        /// @param window: number of ids remembered at least
+        /// @param false_positive_rate: probability of a false duplicate
+        /// @param period: ids are remembered at least this long, 0 to disable
+        BloomWindow(size_t window, double false_positive_rate = 1e-6,
+                    std::chrono::steady_clock::duration period = std::chrono::steady_clock::duration::zero())
+            : _current(0), _window(window ? window : 1), _count(0), _period(period),
+              _rotated(std::chrono::steady_clock::now()) {
+            // optimal size and number of hash functions for _window ids
+            const double ln2 = std::log(2.0);
+            double bits = -static_cast<double>(_window) * std::log(false_positive_rate) / (ln2*ln2);
+            _nbits = (static_cast<size_t>(bits) + 63) / 64 * 64;
+            _nhashes = static_cast<unsigned>(std::ceil(bits / _window * ln2));
+            if(_nhashes == 0)
+                _nhashes = 1;
+            _bits[0].assign(_nbits / 64, 0);
+            _bits[1].assign(_nbits / 64, 0);
+        }
+
+        /// Checks whether a hashed id has been added within the window.
+        ///
+        /// The filters older than the period are dropped first: an id is
+        /// forgotten in time even if nothing is added meanwhile.
+        ///
+        /// @param hash: hash of the id
+        /// @return true if seen (or false positive)
+        bool contains(uint64_t hash) {
+            expire_helper();
+            return contains_helper(_bits[0], hash) || contains_helper(_bits[1], hash);
+        }
+
+        /// Adds a hashed id to the window.
+        ///
+        /// @param hash: hash of the id
+        /// @return no return
+        void insert(uint64_t hash) {
+            expire_helper();
+            if(_count >= _window)
+                rotate();
+            uint64_t h1 = mix(hash);
+            uint64_t h2 = mix(h1) | 1;
+            std::vector<uint64_t>& bits = _bits[_current];
+            for(unsigned i=0; i<_nhashes; ++i) {
+                size_t bit = (h1 + i*h2) % _nbits;
+                bits[bit / 64] |= uint64_t(1) << (bit % 64);
+            }
+            ++_count;
+        }
+
+        /// Forgets all the ids.
+        ///
+        /// @param no param
+        /// @return no return
+        void clear() {
+            std::fill(_bits[0].begin(), _bits[0].end(), 0);
+            std::fill(_bits[1].begin(), _bits[1].end(), 0);
+            _count = 0;
+            _rotated = std::chrono::steady_clock::now();
+        }
+
+    private:
+        // finalizer of MurmurHash3, std::hash of integers is the identity
+        static uint64_t mix(uint64_t h) {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        bool contains_helper(const std::vector<uint64_t>& bits, uint64_t hash) const {
+            uint64_t h1 = mix(hash);
+            uint64_t h2 = mix(h1) | 1;
+            for(unsigned i=0; i<_nhashes; ++i) {
+                size_t bit = (h1 + i*h2) % _nbits;
+                if(!(bits[bit / 64] & (uint64_t(1) << (bit % 64))))
+                    return false;
+            }
+            return true;
+        }
+
+        /// Rotates the filters once the current one is older than the
+        /// period; clears both if even the previous one is, after an idle
+        /// time longer than two periods.
+        void expire_helper() {
+            if(!_period.count())
+                return;
+            std::chrono::steady_clock::duration age = std::chrono::steady_clock::now() - _rotated;
+            if(age >= 2*_period)
+                clear();
+            else if(age >= _period)
+                rotate();
+        }
+
+        void rotate() {
+            _current ^= 1;
+            std::fill(_bits[_current].begin(), _bits[_current].end(), 0);
+            _count = 0;
+            _rotated = std::chrono::steady_clock::now();
+        }
+    };
+
+    // Default id extractor: the items expose their id via get_id()
+    struct GetId {
+        template<typename T>
+        auto operator()(T& item) const -> decltype(item->get_id()) {
+            return item->get_id();
+        }
+    };
+
+    /// Thread-safe FIFO with duplicate suppression.
+    ///
+    /// push() rejects with Status::DUPLICATE the items whose id has been
+    /// pushed within the window, before they take a slot. The filter is
+    /// checked inside the critical section of the FIFO: it adds a few
+    /// hashes and cache-line reads, no lock. Being a Bloom filter it may
+    /// reject a fresh id with the (small) probability set in the constructor.
+    ///
+    /// Example usage:
+    ///
+    ///     class Message {
+    ///         public:
+    ///             uint64_t _id;
+    ///             uint64_t get_id(){ return _id; }
+    ///     };
+    ///
+    ///     tsFIFO::DedupFIFO<std::unique_ptr<Message>> fifo(100, 10000); // the last 10000 ids
+    ///     if( fifo.push(msg) == tsFIFO::Status::DUPLICATE )
+    ///         std::cout << "Already delivered.\n";
+    ///
+    template <  typename T,
+                ActionIfFull action_if_full = ActionIfFull::DumpFirstEntry,
+                typename IdExtractor = GetId> class DedupFIFO
+                : public FIFO<T, action_if_full> {
+
+        using Id = typename std::decay<decltype(std::declval<IdExtractor&>()(std::declval<T&>()))>::type;
+
+        private:
+            BloomWindow     _filter;
+            IdExtractor     _id_of;
+            std::hash<Id>   _hash;
+
+        public:
+            /// @param size: max number of items
+            /// @param window: number of pushes within which an id is a duplicate
+            /// @param false_positive_rate: probability to reject a fresh id
+            /// @param period: time within which an id is a duplicate, 0 to disable
+            DedupFIFO(int size, size_t window, double false_positive_rate = 1e-6,
+                      std::chrono::steady_clock::duration period = std::chrono::steady_clock::duration::zero(),
+                      IdExtractor id_of = IdExtractor())
+                : FIFO<T, action_if_full>(size), _filter(window, false_positive_rate, period), _id_of(id_of) {}
+            ~DedupFIFO(){}
+
+            /// Adds an item into the FIFO unless it is a duplicate. (Thread-safe)
+            ///
+            /// If the FIFO is full ActionIfFull defines the action to undertake.
+            /// The id of an item that did not enter the FIFO is not remembered.
+            ///
+            /// @param item: element to push into the fifo
+            /// @return Status::DUPLICATE, Status::FULL or Status::SUCCESS
+            Status push(T& item) override {
+                uint64_t hash = _hash(_id_of(item));
+                std::unique_lock<std::mutex> _lock(this->_mutex);
+                // push_helper() would release the mutex while waiting for
+                // the commit: wait here, the check and the insert stay atomic
+                while(this->_claimed) {
+                    this->_condv.wait(_lock);
+                }
+                if(_filter.contains(hash))
+                    return Status::DUPLICATE;
+                bool pushed;
+                Status status = this->push_helper(item, _lock, pushed);
+                if(pushed)
+                    _filter.insert(hash);
+                _lock.unlock();
+                this->dispatch_helper();
+                return status;
+            }
+
+            /// Forgets all the ids seen. (Thread-safe)
+            ///
+            /// @param no param
+            /// @return no param
+            void clear_ids() {
+                std::unique_lock<std::mutex> _lock(this->_mutex);
+                _filter.clear();
+            }
+    };
+};
+
+#endif
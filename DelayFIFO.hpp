@@ -0,0 +1,423 @@
+/*	=========================================================================
+	Company:
+	Filename: DelayFIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Thread-safe FIFO delivering each item once its due time
+                    has come. The items wait in a hierarchical timing wheel.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __DELAYFIFO_HPP__
+#define __DELAYFIFO_HPP__
+
+#include "FIFO.hpp"
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <chrono>
+#include <utility>
+
+namespace tsFIFO {
+
+    /// Thread-safe delay queue.
+    ///
+    /// push_after() and push_at() add an item that cannot be pulled before
+    /// its due time. pull() blocks until the earliest item is due; the items
+    /// due at the same tick are pulled in the order they were pushed.
+    ///
+    /// The items wait in a hierarchical timing wheel: LEVELS wheels of 64
+    /// slots, a slot of level l spanning 64^l ticks. Pushing is O(1). A slot
+    /// is emptied into the lower levels when the time reaches it, so each
+    /// item moves at most LEVELS times. A bitmap per level gives the next
+    /// non-empty slot with a count-trailing-zeros: the consumers sleep until
+    /// exactly that time instead of polling. The slot of a far item is
+    /// reached before the item is due, the consumer then sleeps again
+    /// until the item itself.
+    ///
+    /// Example usage:
+    ///
+    ///     tsFIFO::DelayFIFO<std::unique_ptr<Job>> fifo(1000);
+    ///     fifo.push_after(job, std::chrono::milliseconds(250)); // retry later
+    ///     fifo.pull(job); // blocks until a job is due
+    ///
+    template<typename T, ActionIfFull action_if_full = ActionIfFull::DumpFirstEntry> class DelayFIFO {
+
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    protected:
+        static const unsigned SLOT_BITS = 6;
+        static const unsigned SLOTS = 1u << SLOT_BITS;
+        static const unsigned LEVELS = (64 + SLOT_BITS - 1) / SLOT_BITS; ///< enough for any 64-bit tick
+        static const uint32_t NIL = static_cast<uint32_t>(-1);
+
+        struct Node {
+            T           _item;
+            uint64_t    _due;   ///< due tick
+            uint32_t    _next;
+        };
+
+        struct List {
+            uint32_t _head;
+            uint32_t _tail;
+        };
+
+        std::vector<Node>       _nodes;     ///< all the nodes, indexed by the lists
+        uint32_t                _free;      ///< free list of the nodes
+        List                    _slots[LEVELS][SLOTS];
+        uint64_t                _bitmaps[LEVELS];   ///< non-empty slots of each level
+        List                    _ready;     ///< items already due
+        uint64_t                _now;       ///< current tick of the wheel
+        int                     _size;
+        int                     _max_size;
+        Clock::time_point       _start;     ///< time of tick 0
+        Clock::duration         _tick;
+        std::condition_variable _condv;
+        std::mutex              _mutex;
+
+    public:
+        /// @param size: max number of items
+        /// @param tick: resolution of the due times
+        DelayFIFO(int size = 0, Clock::duration tick = std::chrono::milliseconds(1))
+            : _free(NIL), _now(0), _size(0), _max_size(size), _start(Clock::now()), _tick(tick) {
+            for(unsigned l=0; l<LEVELS; ++l) {
+                for(unsigned s=0; s<SLOTS; ++s)
+                    _slots[l][s] = List{NIL, NIL};
+                _bitmaps[l] = 0;
+            }
+            _ready = List{NIL, NIL};
+        }
+        virtual ~DelayFIFO() {
+            clear();
+        }
+
+    public:
+        /// Adds an item due now. (Thread-safe)
+        ///
+        /// @param item: element to push into the fifo
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push(T& item) {
+            return push_at(item, Clock::now());
+        }
+
+        /// Adds an item due after a delay. (Thread-safe)
+        ///
+        /// @param item: element to push into the fifo
+        /// @param delay: time before the item can be pulled
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push_after(T& item, Clock::duration delay) {
+            return push_at(item, Clock::now() + delay);
+        }
+
+        /// Adds an item due at a given time. (Thread-safe)
+        ///
+        /// If the FIFO is full ActionIfFull defines the action to undertake:
+        /// DumpFirstEntry dumps the item due first.
+        ///
+        /// @param item: element to push into the fifo
+        /// @param time: time from which the item can be pulled
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push_at(T& item, Clock::time_point time) {
+            uint64_t due = 0;
+            if(time > _start)
+                // rounded up, the item is never delivered early
+                due = (time - _start + _tick - Clock::duration(1)) / _tick;
+            std::unique_lock<std::mutex> _lock(_mutex);
+            if(_size >= _max_size) {
+                if(action_if_full == ActionIfFull::DumpFirstEntry && _size > 0) {
+                    T first = pop_earliest_helper(); // dump the item due first
+                    clear_helper(first);
+                    insert_helper(new_node(item, due)); // add the new one
+                }
+                return Status::FULL;
+            }
+            insert_helper(new_node(item, due));
+            _condv.notify_one();
+            return Status::SUCCESS;
+        }
+
+        /// Retrieves an item from the FIFO. (Thread-safe)
+        ///
+        /// The item due first is pulled. This function blocks until an item
+        /// is due.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @return no return
+        void pull(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            for(;;) {
+                advance_helper(current_tick());
+                if(_ready._head != NIL)
+                    break;
+                if(_size == 0)
+                    _condv.wait(_lock);
+                else
+                    _condv.wait_until(_lock, time_of(next_tick_helper()));
+            }
+            item = pop_ready_helper();
+        }
+
+        /// Retrieves an item from the FIFO. (Thread-safe)
+        ///
+        /// The item due first is pulled. This function blocks until an item
+        /// is due or the timeout is reached.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @param timeout: an integer defining the max amount of time to wait for a due item
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status pull(T& item, unsigned timeout) {
+            Clock::time_point until = Clock::now() + std::chrono::milliseconds(timeout);
+            std::unique_lock<std::mutex> _lock(_mutex);
+            for(;;) {
+                advance_helper(current_tick());
+                if(_ready._head != NIL)
+                    break;
+                Clock::time_point wake = until;
+                if(_size > 0 && time_of(next_tick_helper()) < until)
+                    wake = time_of(next_tick_helper());
+                if(_condv.wait_until(_lock, wake)==std::cv_status::timeout && Clock::now() >= until) {
+                    advance_helper(current_tick());
+                    if(_ready._head != NIL)
+                        break;
+                    return Status::TIMEOUT;
+                }
+            }
+            item = pop_ready_helper();
+            return Status::SUCCESS;
+        }
+
+        /// Returns the current number of items, due or not. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return current number of items in the fifo
+        int size() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _size;
+        }
+
+        /// Sets the max FIFO size. (Thread-safe)
+        ///
+        /// @param size: integer defining the max fifo size
+        /// @return no param
+        void set_max_size(int size) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            _max_size = size;
+        }
+
+        /// Gets the max FIFO size. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return max fifo size
+        int get_max_size() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _max_size;
+        }
+
+        /// Deletes all the items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        void clear() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            clear_list_helper(_ready);
+            for(unsigned l=0; l<LEVELS; ++l) {
+                for(unsigned s=0; s<SLOTS; ++s)
+                    clear_list_helper(_slots[l][s]);
+                _bitmaps[l] = 0;
+            }
+            _nodes.clear();
+            _free = NIL;
+            _size = 0;
+        }
+
+        /// Check if FIFO is full. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        bool is_full() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _size >= _max_size;
+        }
+
+    protected:
+        uint64_t current_tick() const {
+            return (Clock::now() - _start) / _tick;
+        }
+
+        Clock::time_point time_of(uint64_t tick) const {
+            return _start + _tick * tick;
+        }
+
+        uint32_t new_node(T& item, uint64_t due) {
+            uint32_t index;
+            if(_free != NIL) {
+                index = _free;
+                _free = _nodes[index]._next;
+                _nodes[index]._item = std::move(item);
+                _nodes[index]._due = due;
+            } else {
+                index = _nodes.size();
+                _nodes.push_back(Node{std::move(item), due, NIL});
+            }
+            ++_size;
+            return index;
+        }
+
+        T free_node(uint32_t index) {
+            T item = std::move(_nodes[index]._item);
+            _nodes[index]._next = _free;
+            _free = index;
+            --_size;
+            return item;
+        }
+
+        void append(List& list, uint32_t index) {
+            _nodes[index]._next = NIL;
+            if(list._tail == NIL)
+                list._head = index;
+            else
+                _nodes[list._tail]._next = index;
+            list._tail = index;
+        }
+
+        /// Puts a node in the ready list or in the slot of its due tick.
+        ///
+        /// The level is given by the highest bit differing between the due
+        /// tick and the current tick.
+        ///
+        /// @param index: the node
+        /// @return no return
+        void insert_helper(uint32_t index) {
+            uint64_t due = _nodes[index]._due;
+            if(due <= _now) {
+                append(_ready, index);
+                return;
+            }
+            unsigned level = (63 - __builtin_clzll(due ^ _now)) / SLOT_BITS;
+            unsigned slot = (due >> (level*SLOT_BITS)) & (SLOTS - 1);
+            append(_slots[level][slot], index);
+            _bitmaps[level] |= uint64_t(1) << slot;
+        }
+
+        /// Finds the lowest non-empty level, the earliest items are there.
+        ///
+        /// @param level: the level found
+        /// @return false if the wheel is empty
+        bool lowest_level_helper(unsigned& level) const {
+            for(level=0; level<LEVELS; ++level)
+                if(_bitmaps[level])
+                    return true;
+            return false;
+        }
+
+        /// Tick at which the first non-empty slot is reached.
+        ///
+        /// @param no param
+        /// @return the tick, or the current one if the wheel is empty
+        uint64_t next_tick_helper() const {
+            unsigned level;
+            if(!lowest_level_helper(level))
+                return _now;
+            unsigned shift = level*SLOT_BITS;
+            uint64_t slot = __builtin_ctzll(_bitmaps[level]);
+            // the upper digits of the current tick, then the slot
+            uint64_t upper = (shift + SLOT_BITS >= 64) ? 0 : (_now >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+            return upper | (slot << shift);
+        }
+
+        /// Moves the wheel forward to a tick. The slots reached on the way
+        /// are emptied: into the ready list for level 0, into the lower
+        /// levels otherwise.
+        ///
+        /// @param target: the tick to reach
+        /// @return no return
+        void advance_helper(uint64_t target) {
+            while(_now < target) {
+                unsigned level;
+                if(!lowest_level_helper(level)) {
+                    _now = target;
+                    break;
+                }
+                uint64_t tick = next_tick_helper();
+                if(tick > target) {
+                    _now = target;
+                    break;
+                }
+                _now = tick;
+                unsigned slot = __builtin_ctzll(_bitmaps[level]);
+                List list = _slots[level][slot];
+                _slots[level][slot] = List{NIL, NIL};
+                _bitmaps[level] &= ~(uint64_t(1) << slot);
+                if(level == 0) {
+                    // all due now, keep their order
+                    if(_ready._tail == NIL)
+                        _ready._head = list._head;
+                    else
+                        _nodes[_ready._tail]._next = list._head;
+                    _ready._tail = list._tail;
+                } else {
+                    for(uint32_t index = list._head; index != NIL; ) {
+                        uint32_t next = _nodes[index]._next;
+                        insert_helper(index);
+                        index = next;
+                    }
+                }
+            }
+        }
+
+        T pop_ready_helper() {
+            uint32_t index = _ready._head;
+            _ready._head = _nodes[index]._next;
+            if(_ready._head == NIL)
+                _ready._tail = NIL;
+            T item = free_node(index);
+            if(_size > 0)
+                _condv.notify_one(); // the next item may be due already
+            return item;
+        }
+
+        /// Removes the item due first, wherever it is.
+        ///
+        /// @param no param
+        /// @return the item
+        T pop_earliest_helper() {
+            if(_ready._head != NIL)
+                return pop_ready_helper();
+            unsigned level;
+            lowest_level_helper(level);
+            unsigned slot = __builtin_ctzll(_bitmaps[level]);
+            List& list = _slots[level][slot];
+            // the slot spans several ticks above level 0
+            uint32_t best = list._head, best_prev = NIL;
+            for(uint32_t prev = list._head, index = _nodes[prev]._next; index != NIL; prev = index, index = _nodes[index]._next) {
+                if(_nodes[index]._due < _nodes[best]._due) {
+                    best = index;
+                    best_prev = prev;
+                }
+            }
+            if(best_prev == NIL)
+                list._head = _nodes[best]._next;
+            else
+                _nodes[best_prev]._next = _nodes[best]._next;
+            if(list._tail == best)
+                list._tail = best_prev;
+            if(list._head == NIL)
+                _bitmaps[level] &= ~(uint64_t(1) << slot);
+            return free_node(best);
+        }
+
+        void clear_list_helper(List& list) {
+            for(uint32_t index = list._head; index != NIL; index = _nodes[index]._next) {
+                // For C-style pointers, clear_helper() calls delete.
+                clear_helper(_nodes[index]._item);
+            }
+            list = List{NIL, NIL};
+        }
+    };
+};
+
+#endif
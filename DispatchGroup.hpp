@@ -0,0 +1,220 @@
+/*	=========================================================================
+	Company:
+	Filename: DispatchGroup.hpp
+	Last modifed:   17.10.2026
+	Description:    Group of FIFOs, one per worker, fed by a dispatcher
+                    choosing the less loaded of two random FIFOs.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __DISPATCHGROUP_HPP__
+#define __DISPATCHGROUP_HPP__
+
+#include "FIFO.hpp"
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <functional>
+
+namespace tsFIFO {
+
+    /// Thread-safe group of FIFOs balanced by the power of two choices.
+    ///
+    /// Each worker pulls from its own FIFO, by index, and keeps its data in
+    /// its cache. push() samples two FIFOs at random and pushes to the one
+    /// with fewer items: a slow worker gets fewer items than with a round
+    /// robin, and the load stays close to the best without a lock shared
+    /// by all the producers. The depth of each FIFO is an atomic counter
+    /// on its own cache line, read and updated with relaxed ordering: an
+    /// approximate depth is enough to choose.
+    ///
+    /// push(item, key) makes the keys sticky: the items with the same key
+    /// go to the same FIFO, in order and to the same cache, as long as its
+    /// depth does not exceed the one of the less loaded of two random
+    /// FIFOs by more than max_skew. Then the key moves there. The keys are
+    /// hashed into a table of slots; two keys sharing a slot move together.
+    ///
+    /// Example usage:
+    ///
+    ///     tsFIFO::DispatchGroup<std::unique_ptr<Request>> group(8, 100); // 8 workers
+    ///     group.push(request);                   // the less loaded of two
+    ///     group.push(request, request->client()); // the FIFO of the client
+    ///
+    ///     // worker thread i
+    ///     while( group.pull(i, request, 100) == tsFIFO::Status::SUCCESS )
+    ///         serve(*request);
+    ///
+    template<typename T, ActionIfFull action_if_full = ActionIfFull::DumpFirstEntry> class DispatchGroup {
+
+    protected:
+        /// One FIFO per cache line, the workers do not share anything. The
+        /// depth, read and updated by every producer, has a line of its own:
+        /// it does not invalidate the FIFO of the worker.
+        struct alignas(64) Lane : CacheAligned {
+            alignas(64) std::atomic<int>        _depth;
+            alignas(64) FIFO<T, action_if_full> _fifo;
+
+            Lane(int size) : _depth(0), _fifo(size) {}
+        };
+
+        std::vector<std::unique_ptr<Lane>>  _lanes;
+        int                                 _max_skew;
+        std::unique_ptr<std::atomic<int>[]> _affinity;  ///< FIFO of each slot of keys + 1, 0 if none
+        size_t                              _slots;
+
+    public:
+        /// @param fifos: number of FIFOs, one per worker
+        /// @param size: max number of items of each FIFO
+        /// @param max_skew: extra depth a sticky key tolerates before moving
+        /// @param slots: number of slots of the sticky keys
+        DispatchGroup(int fifos, int size, int max_skew = 16, size_t slots = 4096)
+            : _max_skew(max_skew), _affinity(new std::atomic<int>[slots > 0 ? slots : 1]),
+              _slots(slots > 0 ? slots : 1) {
+            for(int i=0; i<(fifos > 0 ? fifos : 1); ++i)
+                _lanes.emplace_back(new Lane(size));
+            for(size_t i=0; i<_slots; ++i)
+                _affinity[i].store(0, std::memory_order_relaxed);
+        }
+        virtual ~DispatchGroup() {}
+        DispatchGroup(const DispatchGroup&) = delete;
+        DispatchGroup& operator=(const DispatchGroup&) = delete;
+
+    public:
+        /// Adds an item into the less loaded of two random FIFOs. (Thread-safe)
+        ///
+        /// If that FIFO is full ActionIfFull defines the action to undertake.
+        ///
+        /// @param item: element to push into the group
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push(T& item) {
+            return push_helper(choose_helper(), item);
+        }
+
+        /// Adds an item into the FIFO of its key. (Thread-safe)
+        ///
+        /// The first item of a key goes to the less loaded of two random
+        /// FIFOs, the next ones to the same FIFO unless it is max_skew items
+        /// deeper than the less loaded of two random FIFOs.
+        ///
+        /// @param item: element to push into the group
+        /// @param key: the key of the item, hashed by std::hash
+        /// @return either Status::FULL or Status::SUCCESS
+        template<typename Key>
+        Status push(T& item, const Key& key) {
+            std::atomic<int>& slot = _affinity[std::hash<Key>()(key) % _slots];
+            int sticky = slot.load(std::memory_order_relaxed) - 1;
+            int index = choose_helper();
+            if(sticky >= 0 && depth_helper(sticky) <= depth_helper(index) + _max_skew)
+                index = sticky;
+            else
+                slot.store(index + 1, std::memory_order_relaxed);
+            return push_helper(index, item);
+        }
+
+        /// Retrieves an item from the FIFO of a worker. (Thread-safe)
+        ///
+        /// If the FIFO is empty this function blocks until new data are
+        /// available.
+        ///
+        /// @param index: index of the FIFO
+        /// @param item: element pulled from the FIFO
+        /// @return no return
+        void pull(int index, T& item) {
+            Lane& lane = *_lanes[index];
+            lane._fifo.pull(item);
+            lane._depth.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        /// Retrieves an item from the FIFO of a worker. (Thread-safe)
+        ///
+        /// If the FIFO is empty this function blocks until new data are
+        /// available or the timeout is reached.
+        ///
+        /// @param index: index of the FIFO
+        /// @param item: element pulled from the FIFO
+        /// @param timeout: max amount of time to wait for a new item [ms]
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status pull(int index, T& item, unsigned timeout) {
+            Lane& lane = *_lanes[index];
+            Status status = lane._fifo.pull(item, timeout);
+            if(status == Status::SUCCESS)
+                lane._depth.fetch_sub(1, std::memory_order_relaxed);
+            return status;
+        }
+
+        /// Gets the number of FIFOs.
+        ///
+        /// @param no param
+        /// @return number of FIFOs
+        int fifos() const {
+            return _lanes.size();
+        }
+
+        /// Returns the approximate number of items of a FIFO. (Thread-safe)
+        ///
+        /// @param index: index of the FIFO
+        /// @return the depth counter of the FIFO
+        int size(int index) {
+            return depth_helper(index);
+        }
+
+        /// Returns the approximate number of items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return the sum of the depth counters
+        int size() {
+            int size = 0;
+            for(int i=0; i<fifos(); ++i)
+                size += depth_helper(i);
+            return size;
+        }
+
+    protected:
+        int depth_helper(int index) {
+            return _lanes[index]->_depth.load(std::memory_order_relaxed);
+        }
+
+        /// Samples two different FIFOs at random.
+        ///
+        /// @param no param
+        /// @return index of the less loaded one
+        int choose_helper() {
+            const unsigned n = _lanes.size();
+            if(n == 1)
+                return 0;
+            uint32_t r = random_helper();
+            unsigned a = r % n;
+            unsigned b = (a + 1 + (r >> 16) % (n - 1)) % n;
+            return depth_helper(b) < depth_helper(a) ? b : a;
+        }
+
+        /// Counts the item before pushing it: a worker pulling it at once
+        /// does not see a negative depth.
+        Status push_helper(int index, T& item) {
+            Lane& lane = *_lanes[index];
+            lane._depth.fetch_add(1, std::memory_order_relaxed);
+            Status status = lane._fifo.push(item);
+            // either refused, or pushed in place of the oldest item
+            if(status == Status::FULL)
+                lane._depth.fetch_sub(1, std::memory_order_relaxed);
+            return status;
+        }
+
+        /// xorshift32, one state per thread: no shared cache line.
+        static uint32_t random_helper() {
+            thread_local uint32_t state = static_cast<uint32_t>(
+                std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+    };
+};
+
+#endif
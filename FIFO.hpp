@@ -23,20 +23,32 @@
 #include <queue>
 #include <chrono>
 #include <memory>
+#include <iterator>
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <stdexcept>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
 #include <sys/time.h>
+#include <sys/eventfd.h>
 
 namespace tsFIFO {
 
     enum class ActionIfFull {
         Nothing = 0, ///< if the FIFO is full the push() just returns
-        DumpFirstEntry = 1 ///< if the FIFO is full the push() dumps the oldest item entered and push the new item in
+        DumpFirstEntry = 1 ///< if the FIFO is full the push() dumps the oldest item entered and push the new item in.
+                           ///< The dumped item is destroyed as in clear(): C-style pointers are deleted.
     };
 
     enum class Status {
         ERROR = -1, ///< when something weird happen
         SUCCESS, ///< when the function call do what you want
         FULL, ///< when the FIFO is full. It does not implies that there was an error.
-        TIMEOUT
+        TIMEOUT,
+        DUPLICATE ///< when the item has already been pushed recently (see DedupFIFO)
     };
 
     // helper function able to dicriminate C-style pointers from other types.
@@ -49,6 +61,46 @@ namespace tsFIFO {
     template<typename T>
     void clear_helper(T& item){}
     
+    /// Base of the types aligned on a cache line, alignas(64).
+    ///
+    /// Before C++17 new and new[] only guarantee the alignment of
+    /// std::max_align_t, these ones return memory aligned on 64 bytes.
+    struct CacheAligned {
+        static void* operator new(std::size_t size) {
+            return allocate_helper(size);
+        }
+        static void* operator new[](std::size_t size) {
+            return allocate_helper(size);
+        }
+        static void operator delete(void* ptr) noexcept {
+            free(ptr);
+        }
+        static void operator delete[](void* ptr) noexcept {
+            free(ptr);
+        }
+
+    private:
+        static void* allocate_helper(std::size_t size) {
+            void* ptr = nullptr;
+            if(posix_memalign(&ptr, 64, size) != 0)
+                throw std::bad_alloc();
+            return ptr;
+        }
+    };
+
+    /// Thread waiting in tsFIFO::select() for any of several FIFOs.
+    struct SelectWaiter {
+        std::mutex              _mutex;
+        std::condition_variable _condv;
+        bool                    _signaled;  ///< one of the FIFOs has received data
+    };
+
+    /// Entry of a SelectWaiter in the list of a FIFO, one per FIFO.
+    struct SelectLink {
+        SelectWaiter*   _waiter;
+        SelectLink*     _prev;
+        SelectLink*     _next;
+    };
 
 
     /// Thread-safe FIFO buffer using STL queue.
@@ -65,6 +117,19 @@ namespace tsFIFO {
     ///     if( fifo.pull(temp, TIMEOUTms) == tsFIFO::ActionIfFull::TIMEOUT )
     ///         std::cout << "Timeout! The FIFO is empty.\n";
     ///
+    /// Big items can be written and read in place, without moving them in
+    /// and out of the FIFO:
+    ///
+    ///     tsFIFO::FIFO<Frame, tsFIFO::ActionIfFull::Nothing> fifo(5);
+    ///     Frame* frame = fifo.claim();
+    ///     if( frame ) {
+    ///         capture_into(frame->pixels);
+    ///         fifo.commit();
+    ///     }
+    ///     frame = fifo.peek();
+    ///     encode(frame->pixels);
+    ///     fifo.release();
+    ///
     template<typename T, ActionIfFull action_if_full = ActionIfFull::DumpFirstEntry> class FIFO {
 
     protected:
@@ -72,35 +137,175 @@ namespace tsFIFO {
         int                     _max_size;
         std::condition_variable _condv; 
         std::mutex              _mutex;
+        std::mutex              _claim_mutex;   ///< held from claim() to commit()
+        std::mutex              _peek_mutex;    ///< held from peek() to release()
+        bool                    _claimed;       ///< the last item is being written
+        bool                    _peeked;        ///< the first item is being read
+        SelectLink*             _selectors;     ///< threads waiting in select()
+        int                     _eventfd;       ///< readable while items are available, -1 if not used
+        bool                    _event_armed;   ///< the eventfd has been written
 
     public:
-        FIFO() : _max_size(0) {}
-        FIFO(int size) : _max_size(size) {}
-        virtual ~FIFO() {}
+        using Executor = std::function<void(std::function<void()>)>;
+        using Handler = std::function<void(std::vector<T>&)>;
+
+    protected:
+        /// State of a subscriber of on_item(), shared with its tasks.
+        struct Subscriber {
+            Executor    _executor;
+            Handler     _handler;
+            size_t      _max_batch;
+            bool        _scheduled;     ///< a task is posted or running
+            bool        _cancelled;
+            bool        _running;       ///< a task is in run_subscriber_helper()
+            bool        _rerun;         ///< the task posted meanwhile has been folded into it
+        };
+
+        std::vector<std::shared_ptr<Subscriber>> _subscribers;
+        std::vector<std::shared_ptr<Subscriber>> _dispatch;    ///< to post once the mutex is released
+        std::atomic<bool>       _dispatch_pending;
+
+    public:
+        /// Handle of a subscription made with on_item(). The subscription
+        /// ends with cancel() or when the handle is destroyed.
+        class Subscription {
+
+            friend class FIFO;
+
+        private:
+            FIFO*                       _fifo;
+            std::shared_ptr<Subscriber> _subscriber;
+
+            Subscription(FIFO* fifo, std::shared_ptr<Subscriber> subscriber)
+                : _fifo(fifo), _subscriber(std::move(subscriber)) {}
+
+        public:
+            Subscription(const Subscription&) = delete;
+            Subscription& operator=(const Subscription&) = delete;
+            ~Subscription() {
+                cancel();
+            }
+
+            /// Stops the invocations of the handler. (Thread-safe)
+            ///
+            /// An invocation already running completes, no other starts.
+            ///
+            /// @param no param
+            /// @return no return
+            void cancel() {
+                if(_fifo) {
+                    _fifo->unsubscribe_helper(_subscriber);
+                    _fifo = nullptr;
+                }
+            }
+        };
+
+    protected:
+
+    public:
+        FIFO() : _max_size(0), _claimed(false), _peeked(false), _selectors(nullptr),
+            _eventfd(-1), _event_armed(false), _dispatch_pending(false) {}
+        FIFO(int size) : _max_size(size), _claimed(false), _peeked(false), _selectors(nullptr),
+            _eventfd(-1), _event_armed(false), _dispatch_pending(false) {}
+        virtual ~FIFO() {
+            if(_eventfd >= 0)
+                ::close(_eventfd);
+        }
 
     public:
         /// Adds an item into the FIFO. (Thread-safe)
         ///
         /// If the FIFO is full ActionIfFull defines the action to undertake.
+        /// While a slot is claimed this function waits for its commit().
         ///
         /// @param item: element to push into the fifo
         /// @return either Status::FULL or Status::SUCCESS
         virtual Status push(T& item) {
             std::unique_lock<std::mutex> _lock(_mutex);
-            // must use _helper() otherwise we lock the mutex twice
+            Status status = push_helper(item, _lock);
+            _lock.unlock();
+            dispatch_helper();
+            return status;
+        }
+
+        /// Adds a group of items into the FIFO, all of them or none. (Thread-safe)
+        ///
+        /// The group is pushed under a single lock: its items are contiguous
+        /// in the FIFO and the consumers find them all at once. If the group
+        /// does not fit ActionIfFull defines the action to undertake:
+        /// DumpFirstEntry dumps the oldest items to make room for the whole
+        /// group, otherwise nothing is pushed. While an item is peeked
+        /// nothing is dumped: the group is not pushed either.
+        ///
+        /// @param first, last: the range of the items, moved into the fifo
+        /// @return Status::SUCCESS, Status::FULL, or Status::ERROR if the
+        ///         group is larger than the fifo
+        template<typename Iterator>
+        Status push_all_or_nothing(Iterator first, Iterator last) {
+            const size_t count = std::distance(first, last);
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(_claimed) {
+                _condv.wait(_lock);
+            }
+            if(count > static_cast<size_t>(_max_size))
+                return Status::ERROR;
+            Status status = Status::SUCCESS;
+            if(_queue.size() + count > static_cast<size_t>(_max_size)) {
+                // as in dump_first_helper(), the peeked item cannot be dumped,
+                // nor the ones behind it without moving it
+                if(action_if_full == ActionIfFull::Nothing || _peeked)
+                    return Status::FULL;
+                while(_queue.size() + count > static_cast<size_t>(_max_size)) {
+                    T item = pull_pop_first(); // dump the the oldest item
+                    clear_helper(item);
+                }
+                status = Status::FULL;
+            }
+            push_range_helper(first, last);
+            _lock.unlock();
+            dispatch_helper();
+            return status;
+        }
+
+        /// Claims a slot at the end of the FIFO to be filled in place. (Thread-safe)
+        ///
+        /// The slot holds a default-constructed T, it is not visible to the
+        /// consumers until commit() is called. Only one slot can be claimed
+        /// at a time: other producers calling claim() or push() wait until
+        /// commit(). If the FIFO is full ActionIfFull defines the action to
+        /// undertake.
+        ///
+        /// @param no param
+        /// @return the slot, or nullptr if the FIFO is full
+        T* claim() {
+            _claim_mutex.lock();
+            std::unique_lock<std::mutex> _lock(_mutex);
             if(is_full_helper()) {
-                if(action_if_full == ActionIfFull::Nothing) {
-                    ; // nothing to do
-                }else if(action_if_full == ActionIfFull::DumpFirstEntry) {
-                    pull_pop_first(); // dump the the oldest item
-                    push_last(item); // add the new one
+                if(action_if_full == ActionIfFull::Nothing || !dump_first_helper()) {
+                    _claim_mutex.unlock();
+                    return nullptr;
                 }
-                return Status::FULL; 
-            } else { 
-                push_last(item); // add item into the FIFO
             }
-            _condv.notify_one();
-            return Status::SUCCESS;
+            _queue.emplace();
+            _claimed = true;
+            return &_queue.back();
+        }
+
+        /// Publishes the slot obtained with claim(). (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no return
+        void commit() {
+            {
+                std::unique_lock<std::mutex> _lock(_mutex);
+                commit_last();
+                _claimed = false;
+                notify_ready_helper();
+            }
+            // the consumers and the producers waiting for the commit
+            _condv.notify_all();
+            _claim_mutex.unlock();
+            dispatch_helper();
         }
 
         /// Retrieves an item from the FIFO. (Thread-safe)
@@ -115,7 +320,7 @@ namespace tsFIFO {
             // if FIFO is empty wait until new data is available.
             // This while loop is necessary if there are multiple 
             // threads pulling at the same time!
-            while(_queue.empty()) { 
+            while(is_empty_helper()) { 
                 _condv.wait(_lock);
             } 
             item = pull_pop_first();
@@ -134,13 +339,73 @@ namespace tsFIFO {
             // if FIFO is empty wait until new data is available.
             // This while loop is necessary if there are multiple
             // threads pulling at the same time!
-            while(_queue.empty()) {
+            while(is_empty_helper()) {
                 if(_condv.wait_for(_lock, std::chrono::milliseconds(timeout))==std::cv_status::timeout)
                     return Status::TIMEOUT;
             }
             item = pull_pop_first();
             return Status::SUCCESS;
         }
+
+        /// Gets the oldest item in place. (Thread-safe)
+        ///
+        /// If the fifo is empty this function blocks until new data are
+        /// available. The item stays in the FIFO until release() is called,
+        /// meanwhile the other consumers wait. Only one item can be peeked
+        /// at a time.
+        ///
+        /// @param no param
+        /// @return the oldest item
+        T* peek() {
+            _peek_mutex.lock();
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(is_empty_helper()) {
+                _condv.wait(_lock);
+            }
+            _peeked = true;
+            return &_queue.front();
+        }
+
+        /// Gets the oldest item in place. (Thread-safe)
+        ///
+        /// If the fifo is empty this function blocks until new data are
+        /// available or the timeout is reached.
+        ///
+        /// @param timeout: an integer defining the max amount of time to wait for a new item
+        /// @return the oldest item, or nullptr on timeout
+        T* peek(unsigned timeout) {
+            _peek_mutex.lock();
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(is_empty_helper()) {
+                if(_condv.wait_for(_lock, std::chrono::milliseconds(timeout))==std::cv_status::timeout) {
+                    _peek_mutex.unlock();
+                    return nullptr;
+                }
+            }
+            _peeked = true;
+            return &_queue.front();
+        }
+
+        /// Removes the item obtained with peek(). (Thread-safe)
+        ///
+        /// The item is destroyed: C-style pointers are deleted as in clear(),
+        /// set the slot to nullptr beforehand to keep the pointee.
+        ///
+        /// @param no param
+        /// @return no return
+        void release() {
+            {
+                std::unique_lock<std::mutex> _lock(_mutex);
+                _peeked = false;
+                T item = pull_pop_first();
+                clear_helper(item);
+                notify_ready_helper();
+            }
+            // the consumers waiting for the release
+            _condv.notify_all();
+            _peek_mutex.unlock();
+            dispatch_helper();
+        }
         
         /// Returns the current number of items. (Thread-safe)
         ///
@@ -148,7 +413,7 @@ namespace tsFIFO {
         /// @return current number of items in the fifo
         int size() {
             std::unique_lock<std::mutex> _lock(_mutex);
-            return _queue.size();
+            return _queue.size() - (_claimed ? 1 : 0);
         }
         
         /// Sets the max FIFO size. (Thread-safe)
@@ -171,6 +436,8 @@ namespace tsFIFO {
         
         /// Deletes all the items. (Thread-safe)
         ///
+        /// Must not be called while an item is claimed or peeked.
+        ///
         /// @param no param
         /// @return no param
         void clear() {
@@ -198,6 +465,121 @@ namespace tsFIFO {
             std::unique_lock<std::mutex> _lock(_mutex);
             return is_full_helper();
         }
+
+        /// Gets a file descriptor readable while the FIFO has items. (Thread-safe)
+        ///
+        /// The eventfd is created on the first call and closed with the
+        /// FIFO. It becomes readable when an item comes into an empty FIFO,
+        /// with one write for the whole burst, and is reset when
+        /// try_pull_bulk() empties the FIFO: poll it with epoll (EPOLLIN),
+        /// then call try_pull_bulk() until it returns 0. Do not read it.
+        /// It may be readable while the FIFO is empty if another consumer
+        /// has pulled the items with pull().
+        ///
+        /// @param no param
+        /// @return the file descriptor
+        int get_eventfd() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            if(_eventfd < 0) {
+                _eventfd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                if(_eventfd < 0)
+                    throw std::runtime_error("FIFO: eventfd() failed: " + std::string(strerror(errno)));
+                if(!is_empty_helper())
+                    arm_event_helper();
+            }
+            return _eventfd;
+        }
+
+        /// Retrieves up to max_items items without waiting. (Thread-safe)
+        ///
+        /// The oldest items are pulled under a single lock. If the FIFO is
+        /// left empty the eventfd, if any, is reset.
+        ///
+        /// @param out: output iterator receiving the items, e.g. std::back_inserter(vector)
+        /// @param max_items: max number of items to pull
+        /// @return number of items pulled, 0 if the fifo is empty
+        template<typename OutputIterator>
+        size_t try_pull_bulk(OutputIterator out, size_t max_items) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            size_t count = 0;
+            for(; count < max_items && !is_empty_helper(); ++count)
+                *out++ = pull_pop_first();
+            if(_eventfd >= 0)
+                disarm_event_helper();
+            _lock.unlock();
+            // the room made
+            dispatch_helper();
+            return count;
+        }
+
+        /// Calls a handler with the items as they arrive. (Thread-safe)
+        ///
+        /// When items are available a task is posted to the executor: it
+        /// pulls up to max_batch items and calls the handler with them,
+        /// then posts itself again while items are left. A subscriber has
+        /// at most one task at a time, so its handler is never called
+        /// concurrently; several subscribers share the items. No thread
+        /// waits in pull(): the executor decides where the handlers run.
+        /// The FIFO must outlive the tasks posted.
+        ///
+        /// @param executor: called with each task to run, e.g. posts it to a thread pool
+        /// @param handler: called with a batch of items
+        /// @param max_batch: max number of items per call of the handler
+        /// @return the subscription, the handler is called until it is destroyed
+        std::shared_ptr<Subscription> on_item(Executor executor, Handler handler, size_t max_batch = 1) {
+            std::shared_ptr<Subscriber> subscriber(new Subscriber{std::move(executor), std::move(handler),
+                                                                  max_batch ? max_batch : 1,
+                                                                  false, false, false, false});
+            {
+                std::unique_lock<std::mutex> _lock(_mutex);
+                _subscribers.push_back(subscriber);
+                if(!is_empty_helper())
+                    schedule_helper(subscriber);
+            }
+            dispatch_helper();
+            return std::shared_ptr<Subscription>(new Subscription(this, subscriber));
+        }
+
+        /// Check if an item can be pulled right now. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return true or false
+        bool is_ready() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return !is_empty_helper();
+        }
+
+        /// Registers a thread waiting in select(). (Thread-safe)
+        ///
+        /// Used by tsFIFO::select(). The waiter is signaled at once if an
+        /// item is available, then at every new item until remove_selector().
+        ///
+        /// @param link: the entry of the waiter, must stay valid until removed
+        /// @return no return
+        void add_selector(SelectLink& link) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            link._prev = nullptr;
+            link._next = _selectors;
+            if(_selectors)
+                _selectors->_prev = &link;
+            _selectors = &link;
+            if(!is_empty_helper())
+                signal_helper(*link._waiter);
+        }
+
+        /// Unregisters a thread waiting in select(). (Thread-safe)
+        ///
+        /// @param link: the entry given to add_selector()
+        /// @return no return
+        void remove_selector(SelectLink& link) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            if(link._prev)
+                link._prev->_next = link._next;
+            else
+                _selectors = link._next;
+            if(link._next)
+                link._next->_prev = link._prev;
+        }
         
     protected:
         /// Gets the first item then pop it	
@@ -219,6 +601,228 @@ namespace tsFIFO {
             _queue.push(std::move(item)); 
         }
         
+        /// Adds an item into the FIFO, the mutex must be locked.
+        ///
+        /// The claimed slot stays the last one: the item waits for its commit.
+        ///
+        /// @param item: element to push into the fifo
+        /// @param lock: the lock of the mutex
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push_helper(T& item, std::unique_lock<std::mutex>& lock) {
+            bool pushed;
+            return push_helper(item, lock, pushed);
+        }
+
+        /// Adds an item into the FIFO, the mutex must be locked.
+        ///
+        /// @param item: element to push into the fifo
+        /// @param lock: the lock of the mutex
+        /// @param pushed: set if the item entered the FIFO, Status::FULL
+        ///                included when the oldest item has been dumped
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push_helper(T& item, std::unique_lock<std::mutex>& lock, bool& pushed) {
+            while(_claimed) {
+                _condv.wait(lock);
+            }
+            pushed = false;
+            // must use _helper() otherwise we lock the mutex twice
+            if(is_full_helper()) {
+                if(action_if_full == ActionIfFull::Nothing) {
+                    ; // nothing to do
+                }else if(action_if_full == ActionIfFull::DumpFirstEntry) {
+                    if(dump_first_helper()) { // dump the the oldest item
+                        push_last(item); // add the new one
+                        pushed = true;
+                    }
+                }
+                return Status::FULL; 
+            } else { 
+                push_last(item); // add item into the FIFO
+                pushed = true;
+            }
+            _condv.notify_one();
+            notify_ready_helper();
+            return Status::SUCCESS;
+        }
+
+        /// Adds a group of items into the FIFO and wakes the consumers, the
+        /// mutex must be locked and the room checked.
+        ///
+        /// @param first, last: the range of the items
+        /// @return no return
+        template<typename Iterator>
+        void push_range_helper(Iterator first, Iterator last) {
+            for(; first != last; ++first)
+                push_last(*first);
+            _condv.notify_all();
+            notify_ready_helper();
+        }
+
+        /// Wakes the threads waiting in select() and arms the eventfd, the
+        /// mutex must be locked.
+        ///
+        /// The waiters are removed under the same mutex: they exist while
+        /// they are in the list. The eventfd is written once, when the
+        /// first item of a burst comes. Without waiters nor eventfd this is
+        /// two tests.
+        ///
+        /// @param no param
+        /// @return no return
+        void notify_ready_helper() {
+            for(SelectLink* link = _selectors; link; link = link->_next)
+                signal_helper(*link->_waiter);
+            if(_eventfd >= 0 && !_event_armed)
+                arm_event_helper();
+            for(std::shared_ptr<Subscriber>& subscriber : _subscribers)
+                schedule_helper(subscriber);
+        }
+
+        /// Marks an idle subscriber to be posted, the mutex must be locked.
+        ///
+        /// The executor may run the task at once: it is called by
+        /// dispatch_helper() once the mutex is released.
+        ///
+        /// @param subscriber: the subscriber
+        /// @return no return
+        void schedule_helper(const std::shared_ptr<Subscriber>& subscriber) {
+            if(subscriber->_scheduled || subscriber->_cancelled)
+                return;
+            subscriber->_scheduled = true;
+            _dispatch.push_back(subscriber);
+            _dispatch_pending.store(true);
+        }
+
+        /// Posts the subscribers marked by schedule_helper(), the mutex must
+        /// not be locked. Without subscribers this is a single test.
+        ///
+        /// Called once the mutex is released by every function adding items
+        /// or room: a derived class waking its own waiters overrides it.
+        ///
+        /// @param no param
+        /// @return no return
+        virtual void dispatch_helper() {
+            if(!_dispatch_pending.load())
+                return;
+            std::vector<std::shared_ptr<Subscriber>> ready;
+            {
+                std::unique_lock<std::mutex> _lock(_mutex);
+                ready.swap(_dispatch);
+                _dispatch_pending.store(false);
+            }
+            for(std::shared_ptr<Subscriber>& subscriber : ready)
+                post_helper(subscriber);
+        }
+
+        void post_helper(std::shared_ptr<Subscriber> subscriber) {
+            Executor& executor = subscriber->_executor;
+            executor([this, subscriber](){ run_subscriber_helper(subscriber); });
+        }
+
+        /// Task of a subscriber: pulls a batch, calls the handler, and posts
+        /// itself again while items are left.
+        ///
+        /// An executor running the task posted at once, e.g. inline, would
+        /// recurse once per batch: the task posted while the previous one
+        /// is still running returns at once and the previous one loops.
+        ///
+        /// @param subscriber: the subscriber
+        /// @return no return
+        void run_subscriber_helper(const std::shared_ptr<Subscriber>& subscriber) {
+            {
+                std::unique_lock<std::mutex> _lock(_mutex);
+                if(subscriber->_running) {
+                    subscriber->_rerun = true;
+                    return;
+                }
+                subscriber->_running = true;
+            }
+            for(;;) {
+                std::vector<T> batch;
+                {
+                    std::unique_lock<std::mutex> _lock(_mutex);
+                    while(!subscriber->_cancelled && batch.size() < subscriber->_max_batch && !is_empty_helper())
+                        batch.push_back(pull_pop_first());
+                    if(_eventfd >= 0)
+                        disarm_event_helper();
+                    if(batch.empty()) {
+                        subscriber->_scheduled = false;
+                        subscriber->_running = false;
+                        return;
+                    }
+                }
+                // the room made
+                dispatch_helper();
+                try {
+                    subscriber->_handler(batch);
+                } catch(...) {
+                    std::unique_lock<std::mutex> _lock(_mutex);
+                    subscriber->_scheduled = false;
+                    subscriber->_running = false;
+                    throw;
+                }
+                {
+                    std::unique_lock<std::mutex> _lock(_mutex);
+                    subscriber->_scheduled = !subscriber->_cancelled && !is_empty_helper();
+                    if(!subscriber->_scheduled) {
+                        subscriber->_running = false;
+                        return;
+                    }
+                    subscriber->_rerun = false;
+                }
+                post_helper(subscriber);
+                {
+                    std::unique_lock<std::mutex> _lock(_mutex);
+                    if(!subscriber->_rerun) {
+                        // run or to be run by the executor
+                        subscriber->_running = false;
+                        return;
+                    }
+                }
+            }
+        }
+
+        void unsubscribe_helper(const std::shared_ptr<Subscriber>& subscriber) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            subscriber->_cancelled = true;
+            for(size_t i=0; i<_subscribers.size(); ++i) {
+                if(_subscribers[i] == subscriber) {
+                    _subscribers.erase(_subscribers.begin() + i);
+                    break;
+                }
+            }
+        }
+
+        void arm_event_helper() {
+            uint64_t one = 1;
+            if(::write(_eventfd, &one, sizeof(one)) == sizeof(one))
+                _event_armed = true;
+        }
+
+        /// Makes the eventfd unreadable once the FIFO is empty, the mutex
+        /// must be locked.
+        ///
+        /// @param no param
+        /// @return no return
+        void disarm_event_helper() {
+            if(_event_armed && is_empty_helper()) {
+                uint64_t count;
+                if(::read(_eventfd, &count, sizeof(count)) == sizeof(count))
+                    _event_armed = false;
+            }
+        }
+
+        static void signal_helper(SelectWaiter& waiter) {
+            std::unique_lock<std::mutex> _lock(waiter._mutex);
+            waiter._signaled = true;
+            waiter._condv.notify_one();
+        }
+
+        /// Accounts the last item once committed
+        ///
+        /// @param no param
+        /// @return no return
+        virtual void commit_last() {}
+
         /// Check if FIFO is full.
         ///
         /// @param no param
@@ -226,6 +830,29 @@ namespace tsFIFO {
         virtual bool is_full_helper() {
             return (_queue.size() >= _max_size);
         }
+
+        /// Check if there is no item to pull: the peeked item and the
+        /// claimed one are not available.
+        ///
+        /// @param no param
+        /// @return true or false
+        bool is_empty_helper() {
+            return _peeked || (_queue.size() <= (_claimed ? 1u : 0u));
+        }
+
+        /// Dumps the oldest item, unless it is being read or written.
+        ///
+        /// The item is destroyed as in clear(): C-style pointers are deleted.
+        ///
+        /// @param no param
+        /// @return true if an item was dumped
+        bool dump_first_helper() {
+            if(is_empty_helper())
+                return false;
+            T item = pull_pop_first();
+            clear_helper(item);
+            return true;
+        }
     };
 };
 
@@ -0,0 +1,360 @@
+/*	=========================================================================
+	Company:
+	Filename: FairFIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Thread-safe FIFO sharing the consumers fairly between
+                    flows of items, with weighted round-robin.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __FAIRFIFO_HPP__
+#define __FAIRFIFO_HPP__
+
+#include "FIFO.hpp"
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <memory>
+#include <unordered_map>
+#include <chrono>
+#include <utility>
+#include <type_traits>
+
+namespace tsFIFO {
+
+    // Default flow extractor: the items expose their flow via get_flow()
+    struct GetFlow {
+        template<typename T>
+        auto operator()(T& item) const -> decltype(item->get_flow()) {
+            return item->get_flow();
+        }
+    };
+
+    /// Thread-safe fair queue.
+    ///
+    /// Each item belongs to a flow, a tenant or a producer, given by the
+    /// flow extractor. The flows have their own queue and limit: a flow
+    /// pushing too fast fills its own queue, not the others'. pull() serves
+    /// the non-empty flows with weighted round-robin: in turn, each flow
+    /// gives up to `weight` items. The non-empty flows are linked in a list
+    /// so that choosing the next one is O(1) whatever the number of flows.
+    ///
+    /// Example usage:
+    ///
+    ///     class Request {
+    ///         public:
+    ///             int _tenant;
+    ///             int get_flow(){ return _tenant; }
+    ///     };
+    ///
+    ///     tsFIFO::FairFIFO<std::unique_ptr<Request>> fifo(10000, 100); // 100 per tenant
+    ///     fifo.set_flow(PREMIUM, 4, 1000); // 4 requests per round, up to 1000 queued
+    ///     fifo.push(request);
+    ///     fifo.pull(request);
+    ///
+    template <  typename T,
+                ActionIfFull action_if_full = ActionIfFull::DumpFirstEntry,
+                typename FlowExtractor = GetFlow> class FairFIFO {
+
+    public:
+        using Key = typename std::decay<decltype(std::declval<FlowExtractor&>()(std::declval<T&>()))>::type;
+
+    protected:
+        struct Flow {
+            std::queue<T>   _queue;
+            unsigned        _weight;    ///< items per round
+            unsigned        _quota;   ///< items left in the current turn
+            int             _max_size;
+            Flow*           _next;      ///< next active flow
+            bool            _active;
+            bool            _set;       ///< set by set_flow(), kept while idle
+            Key             _key;
+        };
+
+        std::unordered_map<Key, std::unique_ptr<Flow>> _flows;
+        Flow*                   _head;      ///< active flows, in round-robin order
+        Flow*                   _tail;
+        FlowExtractor           _flow_of;
+        int                     _size;
+        int                     _max_size;
+        int                     _flow_max_size; ///< limit of the flows not set
+        std::condition_variable _condv;
+        std::mutex              _mutex;
+
+    public:
+        /// @param size: max number of items
+        /// @param flow_size: max number of items of a flow, unless set_flow() says otherwise
+        FairFIFO(int size = 0, int flow_size = 0, FlowExtractor flow_of = FlowExtractor())
+            : _head(nullptr), _tail(nullptr), _flow_of(flow_of),
+              _size(0), _max_size(size), _flow_max_size(flow_size > 0 ? flow_size : size) {}
+        virtual ~FairFIFO() {
+            clear();
+        }
+
+    public:
+        /// Adds an item into the queue of its flow. (Thread-safe)
+        ///
+        /// If the flow or the FIFO is full ActionIfFull defines the action to
+        /// undertake. DumpFirstEntry dumps the oldest item of the same flow,
+        /// or of the longest flow if the FIFO is full: a flow cannot push out
+        /// the items of a shorter one.
+        ///
+        /// @param item: element to push into the fifo
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            Flow& flow = flow_helper(_flow_of(item));
+            Flow* victim = nullptr;
+            if(static_cast<int>(flow._queue.size()) >= flow._max_size)
+                victim = &flow;
+            else if(_size >= _max_size)
+                victim = longest_helper();
+            if(victim) {
+                if(action_if_full == ActionIfFull::DumpFirstEntry && !victim->_queue.empty()) {
+                    T first = pull_pop_first(*victim); // dump the the oldest item
+                    clear_helper(first);
+                    push_last(flow, item); // add the new one
+                    forget_helper(*victim);
+                } else {
+                    forget_helper(flow); // not kept if created for the item
+                }
+                return Status::FULL;
+            }
+            push_last(flow, item);
+            _condv.notify_one();
+            return Status::SUCCESS;
+        }
+
+        /// Retrieves an item from the FIFO. (Thread-safe)
+        ///
+        /// The oldest element of the flow whose turn it is is pulled. If
+        /// the fifo is empty this function blocks until new data are available.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @return no return
+        void pull(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(_size == 0) {
+                _condv.wait(_lock);
+            }
+            item = pull_next();
+        }
+
+        /// Retrieves an item from the FIFO. (Thread-safe)
+        ///
+        /// The oldest element of the flow whose turn it is is pulled. If
+        /// the fifo is empty this function blocks until new data are available
+        /// or the timeout is reached.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @param timeout: an integer defining the max amount of time to wait for a new item
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status pull(T& item, unsigned timeout) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(_size == 0) {
+                if(_condv.wait_for(_lock, std::chrono::milliseconds(timeout))==std::cv_status::timeout)
+                    return Status::TIMEOUT;
+            }
+            item = pull_next();
+            return Status::SUCCESS;
+        }
+
+        /// Sets the weight and the max size of a flow. (Thread-safe)
+        ///
+        /// @param key: the flow
+        /// @param weight: number of items pulled from the flow per round, at least 1
+        /// @param size: max number of items of the flow
+        /// @return no return
+        void set_flow(const Key& key, unsigned weight, int size) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            Flow& flow = flow_helper(key);
+            flow._set = true;
+            flow._weight = weight ? weight : 1;
+            flow._max_size = size;
+        }
+
+        /// Returns the current number of items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return current number of items in the fifo
+        int size() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _size;
+        }
+
+        /// Returns the current number of items of a flow. (Thread-safe)
+        ///
+        /// @param key: the flow
+        /// @return current number of items of the flow
+        int size(const Key& key) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            auto it = _flows.find(key);
+            return (it == _flows.end()) ? 0 : it->second->_queue.size();
+        }
+
+        /// Sets the max FIFO size. (Thread-safe)
+        ///
+        /// @param size: integer defining the max fifo size
+        /// @return no param
+        void set_max_size(int size) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            _max_size = size;
+        }
+
+        /// Gets the max FIFO size. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return max fifo size
+        int get_max_size() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _max_size;
+        }
+
+        /// Deletes all the items. The flows set by set_flow() are kept. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        void clear() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            for(auto it = _flows.begin(); it != _flows.end(); ) {
+                Flow& flow = *it->second;
+                while(!flow._queue.empty()) {
+                    T item = std::move(flow._queue.front());
+                    flow._queue.pop();
+                    // For C-style pointers, clear_helper() calls delete.
+                    clear_helper(item);
+                }
+                flow._active = false;
+                flow._quota = 0;
+                if(flow._set)
+                    ++it;
+                else
+                    it = _flows.erase(it);
+            }
+            _head = _tail = nullptr;
+            _size = 0;
+        }
+
+        /// Check if FIFO is full. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        bool is_full() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _size >= _max_size;
+        }
+
+    protected:
+        /// Finds a flow, creating it with the default settings if needed.
+        ///
+        /// @param key: the flow
+        /// @return the flow
+        Flow& flow_helper(const Key& key) {
+            std::unique_ptr<Flow>& flow = _flows[key];
+            if(!flow)
+                flow.reset(new Flow{std::queue<T>(), 1, 0, _flow_max_size, nullptr, false, false, key});
+            return *flow;
+        }
+
+        /// Finds the active flow with the most items.
+        ///
+        /// @param no param
+        /// @return the flow
+        Flow* longest_helper() {
+            Flow* longest = _head;
+            for(Flow* flow = _head; flow; flow = flow->_next)
+                if(flow->_queue.size() > longest->_queue.size())
+                    longest = flow;
+            return longest;
+        }
+
+        /// Add item into the queue of its flow, the flow joins the round if it was idle
+        ///
+        /// @param flow: the flow of the item
+        /// @param item: the item to add
+        /// @return no return
+        void push_last(Flow& flow, T& item) {
+            flow._queue.push(std::move(item));
+            ++_size;
+            if(!flow._active) {
+                flow._active = true;
+                flow._quota = 0;
+                flow._next = nullptr;
+                if(_tail)
+                    _tail->_next = &flow;
+                else
+                    _head = &flow;
+                _tail = &flow;
+            }
+        }
+
+        /// Gets the first item of a flow then pop it
+        ///
+        /// @param flow: the flow
+        /// @return the item
+        T pull_pop_first(Flow& flow) {
+            T item = std::move(flow._queue.front());
+            flow._queue.pop();
+            --_size;
+            if(flow._queue.empty())
+                unlink_helper(flow);
+            return item;
+        }
+
+        /// Pulls an item from the flow at the head of the round. The flow
+        /// goes to the back of the round once its turn is over.
+        ///
+        /// @param no param
+        /// @return the item
+        T pull_next() {
+            Flow& flow = *_head;
+            if(flow._quota == 0)
+                flow._quota = flow._weight; // its turn starts
+            --flow._quota;
+            T item = pull_pop_first(flow);
+            if(flow._active && flow._quota == 0 && _head != _tail) {
+                _head = flow._next;
+                flow._next = nullptr;
+                _tail->_next = &flow;
+                _tail = &flow;
+            }
+            forget_helper(flow);
+            return item;
+        }
+
+        /// Removes an empty flow from the round.
+        ///
+        /// @param flow: the flow
+        /// @return no return
+        void unlink_helper(Flow& flow) {
+            Flow* prev = nullptr;
+            // the flow is at the head unless an item has been dumped
+            for(Flow* f = _head; f != &flow; f = f->_next)
+                prev = f;
+            if(prev)
+                prev->_next = flow._next;
+            else
+                _head = flow._next;
+            if(_tail == &flow)
+                _tail = prev;
+            flow._next = nullptr;
+            flow._active = false;
+            flow._quota = 0;
+        }
+
+        /// Erases a flow left idle and empty, unless set by set_flow(): the
+        /// flows of the keys seen once do not pile up.
+        ///
+        /// @param flow: the flow, invalid if erased
+        /// @return no return
+        void forget_helper(Flow& flow) {
+            if(!flow._active && !flow._set)
+                _flows.erase(flow._key);
+        }
+    };
+};
+
+#endif
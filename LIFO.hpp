@@ -0,0 +1,374 @@
+/*	=========================================================================
+	Company:
+	Filename: LIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Thread-safe LIFO, the newest item is pulled first. The
+                    C-style pointers are kept in a lock-free stack.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __LIFO_HPP__
+#define __LIFO_HPP__
+
+#include "FIFO.hpp"
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <chrono>
+#include <utility>
+
+namespace tsFIFO {
+
+    /// Thread-safe LIFO buffer using STL deque.
+    ///
+    /// Same API as FIFO but pull() returns the newest item: the data just
+    /// pushed are still in cache, and under overload the stalest work is
+    /// the one left behind. If the LIFO is full DumpFirstEntry dumps the
+    /// bottom of the stack, the oldest item.
+    ///
+    /// LIFO<T*, ActionIfFull::Nothing> is a lock-free stack, see below.
+    ///
+    /// Example usage:
+    ///
+    ///     tsFIFO::LIFO<std::unique_ptr<Request>> lifo(100);
+    ///     lifo.push(request);
+    ///     lifo.pull(request); // the most recent request
+    ///
+    template<typename T, ActionIfFull action_if_full = ActionIfFull::DumpFirstEntry> class LIFO {
+
+    protected:
+        std::deque<T>           _stack;     ///< the top is at the back
+        int                     _max_size;
+        std::condition_variable _condv;
+        std::mutex              _mutex;
+
+    public:
+        LIFO() : _max_size(0) {}
+        LIFO(int size) : _max_size(size) {}
+        virtual ~LIFO() {
+            clear();
+        }
+
+    public:
+        /// Adds an item on top of the LIFO. (Thread-safe)
+        ///
+        /// If the LIFO is full ActionIfFull defines the action to undertake:
+        /// DumpFirstEntry dumps the bottom item, the oldest one.
+        ///
+        /// @param item: element to push into the lifo
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            if(is_full_helper()) {
+                if(action_if_full == ActionIfFull::DumpFirstEntry && !_stack.empty()) {
+                    T bottom = std::move(_stack.front()); // dump the the oldest item
+                    _stack.pop_front();
+                    clear_helper(bottom);
+                    _stack.push_back(std::move(item)); // add the new one
+                }
+                return Status::FULL;
+            }
+            _stack.push_back(std::move(item));
+            _condv.notify_one();
+            return Status::SUCCESS;
+        }
+
+        /// Retrieves an item from the LIFO. (Thread-safe)
+        ///
+        /// The newest element in the LIFO is pulled. If the lifo is empty
+        /// this function blocks until new data are available.
+        ///
+        /// @param item: element pulled from the lifo
+        /// @return no return
+        void pull(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(_stack.empty()) {
+                _condv.wait(_lock);
+            }
+            item = pull_pop_last();
+        }
+
+        /// Retrieves an item from the LIFO. (Thread-safe)
+        ///
+        /// The newest element in the LIFO is pulled. If the lifo is empty
+        /// this function blocks until new data are available or the timeout
+        /// is reached.
+        ///
+        /// @param item: element pulled from the lifo
+        /// @param timeout: an integer defining the max amount of time to wait for a new item
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status pull(T& item, unsigned timeout) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(_stack.empty()) {
+                if(_condv.wait_for(_lock, std::chrono::milliseconds(timeout))==std::cv_status::timeout)
+                    return Status::TIMEOUT;
+            }
+            item = pull_pop_last();
+            return Status::SUCCESS;
+        }
+
+        /// Returns the current number of items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return current number of items in the lifo
+        int size() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _stack.size();
+        }
+
+        /// Sets the max LIFO size. (Thread-safe)
+        ///
+        /// @param size: integer defining the max lifo size
+        /// @return no param
+        void set_max_size(int size) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            _max_size = size;
+        }
+
+        /// Gets the max LIFO size. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return max lifo size
+        int get_max_size() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _max_size;
+        }
+
+        /// Deletes all the items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        void clear() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(!_stack.empty()) {
+                T item = pull_pop_last();
+                // For C-style pointers, clear_helper() calls delete.
+                clear_helper(item);
+            }
+        }
+
+        /// Check if LIFO is full. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        bool is_full() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return is_full_helper();
+        }
+
+    protected:
+        /// Gets the top item then pop it
+        ///
+        /// @param no param
+        /// @return the item
+        T pull_pop_last() {
+            T item = std::move(_stack.back());
+            _stack.pop_back();
+            return item;
+        }
+
+        bool is_full_helper() {
+            return static_cast<int>(_stack.size()) >= _max_size;
+        }
+    };
+
+    /// Lock-free LIFO of C-style pointers (Treiber stack).
+    ///
+    /// The pointers are stored in a pool of max_size nodes allocated once.
+    /// The top of the stack and the list of the free nodes are each a
+    /// single 64-bit word: the index of the first node and a tag
+    /// incremented at every change, so that a node popped and pushed back
+    /// meanwhile (ABA) makes the compare-and-swap fail. push() and the
+    /// pull() that find an item take no lock; a mutex is used only by the
+    /// consumers waiting for an item.
+    ///
+    /// Dumping the bottom item is not possible without a lock: this stack
+    /// is used with ActionIfFull::Nothing only. The size is fixed.
+    ///
+    template<typename T> class LIFO<T*, ActionIfFull::Nothing> {
+
+    protected:
+        static const uint32_t NIL = static_cast<uint32_t>(-1);
+
+        struct Node {
+            T*                      _item;
+            std::atomic<uint32_t>   _next;
+        };
+
+        std::unique_ptr<Node[]>     _nodes;
+        int                         _max_size;
+        alignas(64) std::atomic<uint64_t> _top;     ///< tag << 32 | index of the top node
+        alignas(64) std::atomic<uint64_t> _free;    ///< tag << 32 | index of the first free node
+        alignas(64) std::atomic<int> _size;
+        std::atomic<int>            _sleepers;      ///< consumers waiting for an item
+        std::condition_variable     _condv;
+        std::mutex                  _mutex;         ///< for the waiting consumers only
+
+    public:
+        LIFO(int size) : _nodes(new Node[size]), _max_size(size), _top(NIL), _free(NIL), _size(0), _sleepers(0) {
+            for(int i=size-1; i>=0; --i)
+                push_node(_free, i);
+        }
+        virtual ~LIFO() {
+            clear();
+        }
+
+        LIFO(const LIFO&) = delete;
+        LIFO& operator=(const LIFO&) = delete;
+
+    public:
+        /// Adds an item on top of the LIFO. (Thread-safe, lock-free)
+        ///
+        /// @param item: element to push into the lifo
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push(T*& item) {
+            uint32_t index = pop_node(_free);
+            if(index == NIL)
+                return Status::FULL;
+            _nodes[index]._item = item;
+            push_node(_top, index);
+            _size.fetch_add(1);
+            // the consumers count themselves before checking the stack
+            if(_sleepers.load() > 0) {
+                std::unique_lock<std::mutex> _lock(_mutex);
+                _condv.notify_one();
+            }
+            return Status::SUCCESS;
+        }
+
+        /// Retrieves an item from the LIFO. (Thread-safe)
+        ///
+        /// The newest element in the LIFO is pulled. If the lifo is empty
+        /// this function blocks until new data are available.
+        ///
+        /// @param item: element pulled from the lifo
+        /// @return no return
+        void pull(T*& item) {
+            if(try_pull_helper(item))
+                return;
+            std::unique_lock<std::mutex> _lock(_mutex);
+            _sleepers.fetch_add(1);
+            while(!try_pull_helper(item))
+                _condv.wait(_lock);
+            _sleepers.fetch_sub(1);
+        }
+
+        /// Retrieves an item from the LIFO. (Thread-safe)
+        ///
+        /// The newest element in the LIFO is pulled. If the lifo is empty
+        /// this function blocks until new data are available or the timeout
+        /// is reached.
+        ///
+        /// @param item: element pulled from the lifo
+        /// @param timeout: an integer defining the max amount of time to wait for a new item
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status pull(T*& item, unsigned timeout) {
+            if(try_pull_helper(item))
+                return Status::SUCCESS;
+            auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+            std::unique_lock<std::mutex> _lock(_mutex);
+            _sleepers.fetch_add(1);
+            Status status = Status::SUCCESS;
+            while(!try_pull_helper(item)) {
+                if(_condv.wait_until(_lock, until)==std::cv_status::timeout) {
+                    if(!try_pull_helper(item))
+                        status = Status::TIMEOUT;
+                    break;
+                }
+            }
+            _sleepers.fetch_sub(1);
+            return status;
+        }
+
+        /// Returns the current number of items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return current number of items in the lifo, a snapshot
+        int size() {
+            return _size.load();
+        }
+
+        /// Gets the max LIFO size.
+        ///
+        /// @param no param
+        /// @return max lifo size
+        int get_max_size() const {
+            return _max_size;
+        }
+
+        /// Deletes all the items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        void clear() {
+            T* item;
+            while(try_pull_helper(item))
+                clear_helper(item);
+        }
+
+        /// Check if LIFO is full. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        bool is_full() {
+            return static_cast<uint32_t>(_free.load()) == NIL;
+        }
+
+    protected:
+        bool try_pull_helper(T*& item) {
+            uint32_t index = pop_node(_top);
+            if(index == NIL)
+                return false;
+            _size.fetch_sub(1);
+            item = _nodes[index]._item;
+            push_node(_free, index);
+            return true;
+        }
+
+        /// Pushes a node on a tagged stack.
+        ///
+        /// The head is updated with sequential consistency: a consumer
+        /// counted in _sleepers then finding the stack empty cannot miss
+        /// the push that follows.
+        ///
+        /// @param head: the top of the stack
+        /// @param index: the node
+        /// @return no return
+        void push_node(std::atomic<uint64_t>& head, uint32_t index) {
+            uint64_t old = head.load(std::memory_order_relaxed);
+            uint64_t now;
+            do {
+                _nodes[index]._next.store(static_cast<uint32_t>(old), std::memory_order_relaxed);
+                now = ((old >> 32) + 1) << 32 | index;
+            } while(!head.compare_exchange_weak(old, now));
+        }
+
+        /// Pops a node from a tagged stack.
+        ///
+        /// The next node read may be stale if the top has been popped
+        /// meanwhile: the tag has changed and the compare-and-swap fails.
+        ///
+        /// @param head: the top of the stack
+        /// @return the node or NIL
+        uint32_t pop_node(std::atomic<uint64_t>& head) {
+            uint64_t old = head.load();
+            uint64_t now;
+            do {
+                uint32_t index = static_cast<uint32_t>(old);
+                if(index == NIL)
+                    return NIL;
+                uint32_t next = _nodes[index]._next.load(std::memory_order_relaxed);
+                now = ((old >> 32) + 1) << 32 | next;
+            } while(!head.compare_exchange_weak(old, now));
+            return static_cast<uint32_t>(old);
+        }
+    };
+};
+
+#endif
@@ -0,0 +1,369 @@
+/*	=========================================================================
+	Company:
+	Filename: LeaseFIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Thread-safe FIFO with at-least-once delivery. A pulled
+                    item is leased until acknowledged and redelivered if the
+                    lease expires.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __LEASEFIFO_HPP__
+#define __LEASEFIFO_HPP__
+
+#include "FIFO.hpp"
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <utility>
+
+namespace tsFIFO {
+
+    /// Thread-safe FIFO with leases.
+    ///
+    /// pull_lease() hands out a copy of the oldest item together with a
+    /// ticket, the item itself stays in the FIFO. ack() with the ticket
+    /// retires the item. If the item is not acknowledged within the
+    /// visibility timeout, because the consumer crashed or hangs, the lease
+    /// expires and the item is delivered again, before the other items.
+    ///
+    /// The leased items are kept in a table of max_size slots: a ticket is
+    /// the index of the slot and its generation, so ack() costs O(1) and a
+    /// late ack of a redelivered item is detected. The leases expire in
+    /// the order they were given, a queue of the tickets is enough to find
+    /// the expired ones. ack_batch() retires several items under a single
+    /// lock.
+    ///
+    /// T is copied: use values or std::shared_ptr.
+    ///
+    /// Example usage:
+    ///
+    ///     tsFIFO::LeaseFIFO<std::shared_ptr<Job>> fifo(1000, std::chrono::seconds(30));
+    ///     fifo.push(job);
+    ///
+    ///     // consumer thread
+    ///     tsFIFO::LeaseFIFO<std::shared_ptr<Job>>::Ticket ticket;
+    ///     fifo.pull_lease(job, ticket);
+    ///     run(job);
+    ///     fifo.ack(ticket); // otherwise the job runs again in 30s
+    ///
+    template<typename T, ActionIfFull action_if_full = ActionIfFull::DumpFirstEntry> class LeaseFIFO {
+
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// Proof of lease of an item, to acknowledge it.
+        struct Ticket {
+            uint32_t _slot;
+            uint32_t _generation;
+        };
+
+    protected:
+        static const uint32_t NIL = static_cast<uint32_t>(-1);
+
+        struct Slot {
+            T                   _item;
+            uint32_t            _generation;    ///< incremented when the slot is freed
+            uint32_t            _next;          ///< free list
+            bool                _leased;
+            Clock::time_point   _expiry;
+        };
+
+        std::deque<T>           _queue;     ///< items waiting for a consumer
+        std::deque<T>           _expired;   ///< items whose lease has expired, served first
+        std::vector<Slot>       _slots;     ///< leased items
+        uint32_t                _free;
+        std::deque<Ticket>      _leases;    ///< leases in expiry order, acked ones included
+        int                     _leased;
+        int                     _max_size;
+        Clock::duration         _visibility;
+        uint64_t                _redelivered;
+        std::condition_variable _condv;
+        std::mutex              _mutex;
+
+    public:
+        /// @param size: max number of items, leased ones included
+        /// @param visibility: time given to a consumer to acknowledge an item
+        LeaseFIFO(int size, Clock::duration visibility)
+            : _slots(size), _free(NIL), _leased(0), _max_size(size),
+              _visibility(visibility), _redelivered(0) {
+            for(int i=size-1; i>=0; --i) {
+                _slots[i]._generation = 0;
+                _slots[i]._leased = false;
+                _slots[i]._next = _free;
+                _free = i;
+            }
+        }
+        virtual ~LeaseFIFO() {
+            clear();
+        }
+
+    public:
+        /// Adds an item into the FIFO. (Thread-safe)
+        ///
+        /// If the FIFO is full ActionIfFull defines the action to undertake:
+        /// DumpFirstEntry dumps the oldest item not leased.
+        ///
+        /// @param item: element to push into the fifo
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            if(is_full_helper()) {
+                if(action_if_full == ActionIfFull::DumpFirstEntry && !_queue.empty()) {
+                    T first = std::move(_queue.front()); // dump the the oldest item
+                    _queue.pop_front();
+                    clear_helper(first);
+                    _queue.push_back(std::move(item)); // add the new one
+                }
+                return Status::FULL;
+            }
+            _queue.push_back(std::move(item));
+            _condv.notify_one();
+            return Status::SUCCESS;
+        }
+
+        /// Leases an item of the FIFO. (Thread-safe)
+        ///
+        /// The items whose lease has expired come first, then the oldest
+        /// item. If there is none this function blocks until new data are
+        /// available or a lease expires.
+        ///
+        /// @param item: copy of the leased item
+        /// @param ticket: to acknowledge the item
+        /// @return no return
+        void pull_lease(T& item, Ticket& ticket) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            for(;;) {
+                expire_helper(Clock::now());
+                if(!is_empty_helper())
+                    break;
+                if(_leases.empty())
+                    _condv.wait(_lock);
+                else
+                    _condv.wait_until(_lock, _slots[_leases.front()._slot]._expiry);
+            }
+            lease_helper(item, ticket);
+        }
+
+        /// Leases an item of the FIFO. (Thread-safe)
+        ///
+        /// The items whose lease has expired come first, then the oldest
+        /// item. If there is none this function blocks until new data are
+        /// available, a lease expires or the timeout is reached.
+        ///
+        /// @param item: copy of the leased item
+        /// @param ticket: to acknowledge the item
+        /// @param timeout: an integer defining the max amount of time to wait for an item
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status pull_lease(T& item, Ticket& ticket, unsigned timeout) {
+            Clock::time_point until = Clock::now() + std::chrono::milliseconds(timeout);
+            std::unique_lock<std::mutex> _lock(_mutex);
+            for(;;) {
+                Clock::time_point now = Clock::now();
+                expire_helper(now);
+                if(!is_empty_helper())
+                    break;
+                if(now >= until)
+                    return Status::TIMEOUT;
+                Clock::time_point wake = until;
+                if(!_leases.empty() && _slots[_leases.front()._slot]._expiry < until)
+                    wake = _slots[_leases.front()._slot]._expiry;
+                _condv.wait_until(_lock, wake);
+            }
+            lease_helper(item, ticket);
+            return Status::SUCCESS;
+        }
+
+        /// Retires a leased item. (Thread-safe)
+        ///
+        /// For C-style pointers the item is deleted, as in clear().
+        ///
+        /// @param ticket: the ticket given with the item
+        /// @return Status::SUCCESS or Status::ERROR if the lease has expired
+        ///         or the item has already been acknowledged
+        Status ack(const Ticket& ticket) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return ack_helper(ticket);
+        }
+
+        /// Retires several leased items at once. (Thread-safe)
+        ///
+        /// @param tickets: the tickets given with the items
+        /// @param count: number of tickets
+        /// @return number of items retired, the others had expired or had
+        ///         already been acknowledged
+        int ack_batch(const Ticket* tickets, size_t count) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            int retired = 0;
+            for(size_t i=0; i<count; ++i)
+                if(ack_helper(tickets[i]) == Status::SUCCESS)
+                    ++retired;
+            return retired;
+        }
+
+        /// Returns the current number of items, leased ones included. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return current number of items in the fifo
+        int size() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _queue.size() + _expired.size() + _leased;
+        }
+
+        /// Returns the current number of leased items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return number of items waiting for an ack
+        int size_leased() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _leased;
+        }
+
+        /// Returns the number of expired leases. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return number of items delivered again since the creation of the fifo
+        uint64_t get_redelivered() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _redelivered;
+        }
+
+        /// Gets the max FIFO size.
+        ///
+        /// @param no param
+        /// @return max fifo size
+        int get_max_size() const {
+            return _max_size;
+        }
+
+        /// Deletes all the items, the leased ones too. (Thread-safe)
+        ///
+        /// The tickets of the leased items become invalid.
+        ///
+        /// @param no param
+        /// @return no param
+        void clear() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            for(std::deque<T>* queue : {&_expired, &_queue}) {
+                while(!queue->empty()) {
+                    T item = std::move(queue->front());
+                    queue->pop_front();
+                    // For C-style pointers, clear_helper() calls delete.
+                    clear_helper(item);
+                }
+            }
+            for(const Ticket& ticket : _leases) {
+                Slot& slot = _slots[ticket._slot];
+                if(slot._leased && slot._generation == ticket._generation) {
+                    clear_helper(slot._item);
+                    free_helper(ticket._slot);
+                }
+            }
+            _leases.clear();
+        }
+
+        /// Check if FIFO is full. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        bool is_full() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return is_full_helper();
+        }
+
+    protected:
+        /// Moves the oldest item into a free slot and leases it.
+        ///
+        /// @param item: copy of the leased item
+        /// @param ticket: to acknowledge the item
+        /// @return no return
+        void lease_helper(T& item, Ticket& ticket) {
+            // there is always a free slot: leased + queued <= max_size
+            uint32_t index = _free;
+            Slot& slot = _slots[index];
+            _free = slot._next;
+            std::deque<T>& queue = _expired.empty() ? _queue : _expired;
+            slot._item = std::move(queue.front());
+            queue.pop_front();
+            slot._leased = true;
+            slot._expiry = Clock::now() + _visibility;
+            ++_leased;
+            ticket = Ticket{index, slot._generation};
+            _leases.push_back(ticket);
+            // the first lease: the consumers waiting without a deadline
+            // must wait until it expires instead
+            if(_leases.size() == 1)
+                _condv.notify_all();
+            item = slot._item;
+        }
+
+        Status ack_helper(const Ticket& ticket) {
+            if(ticket._slot >= _slots.size())
+                return Status::ERROR;
+            Slot& slot = _slots[ticket._slot];
+            if(!slot._leased || slot._generation != ticket._generation)
+                return Status::ERROR;
+            clear_helper(slot._item);
+            free_helper(ticket._slot);
+            // the acked tickets at the head of the queue are dropped now,
+            // the others when they reach it
+            while(!_leases.empty() && !is_current(_leases.front()))
+                _leases.pop_front();
+            return Status::SUCCESS;
+        }
+
+        void free_helper(uint32_t index) {
+            Slot& slot = _slots[index];
+            slot._item = T();
+            slot._leased = false;
+            ++slot._generation;
+            slot._next = _free;
+            _free = index;
+            --_leased;
+        }
+
+        bool is_current(const Ticket& ticket) const {
+            const Slot& slot = _slots[ticket._slot];
+            return slot._leased && slot._generation == ticket._generation;
+        }
+
+        /// Moves the items whose lease has expired to the queue served
+        /// first, the oldest lease first.
+        ///
+        /// @param now: the current time
+        /// @return no return
+        void expire_helper(Clock::time_point now) {
+            while(!_leases.empty()) {
+                Ticket ticket = _leases.front();
+                if(is_current(ticket)) {
+                    if(_slots[ticket._slot]._expiry > now)
+                        break;
+                    _expired.push_back(std::move(_slots[ticket._slot]._item));
+                    free_helper(ticket._slot);
+                    ++_redelivered;
+                }
+                _leases.pop_front();
+            }
+        }
+
+        bool is_empty_helper() {
+            return _queue.empty() && _expired.empty();
+        }
+
+        /// Check if FIFO is full.
+        ///
+        /// @param no param
+        /// @return no param
+        bool is_full_helper() {
+            return static_cast<int>(_queue.size() + _expired.size()) + _leased >= _max_size;
+        }
+    };
+};
+
+#endif
@@ -0,0 +1,247 @@
+/*	=========================================================================
+	Company:
+	Filename: MessageFIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Thread-safe FIFO of messages of different types,
+                    constructed in place in a byte ring (see RecordFIFO).
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __MESSAGEFIFO_HPP__
+#define __MESSAGEFIFO_HPP__
+
+#include "RecordFIFO.hpp"
+#include <cstdint>
+#include <new>
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+namespace tsFIFO {
+
+    namespace msg_detail {
+
+        // position of T in the list Ts...
+        template<typename T, typename... Ts>
+        struct index_of;
+
+        template<typename T, typename... Ts>
+        struct index_of<T, T, Ts...> : std::integral_constant<uint16_t, 0> {};
+
+        template<typename T, typename U, typename... Ts>
+        struct index_of<T, U, Ts...> : std::integral_constant<uint16_t, 1 + index_of<T, Ts...>::value> {};
+
+        /// Type-erased operations of a message type
+        struct Ops {
+            void (*destroy)(void* msg);
+            void (*move)(void* dst, void* src); ///< move-constructs dst from src
+        };
+
+        template<typename T>
+        void destroy(void* msg) {
+            static_cast<T*>(msg)->~T();
+        }
+
+        template<typename T>
+        void move(void* dst, void* src) {
+            new (dst) T(std::move(*static_cast<T*>(src)));
+        }
+
+        template<typename Visitor, typename T>
+        void visit(void* msg, Visitor& visitor) {
+            visitor(*static_cast<T*>(msg));
+        }
+    }
+
+    /// Thread-safe FIFO of messages of the types Msgs...
+    ///
+    /// Each message is constructed in place in a byte ring, aligned, and
+    /// tagged with the index of its type in Msgs... The consumer hands a
+    /// visitor to consume(): it is called with a reference to the message
+    /// of the right type, then the message is destroyed in place. Nothing
+    /// is allocated on the heap and nothing is virtual: this is a dense
+    /// command buffer.
+    ///
+    /// Example usage:
+    ///
+    ///     struct Start { int id; };
+    ///     struct Stop { int id; std::string reason; };
+    ///     struct Visitor {
+    ///         void operator()(Start& msg) { start(msg.id); }
+    ///         void operator()(Stop& msg) { stop(msg.id, msg.reason); }
+    ///     };
+    ///     tsFIFO::MessageFIFO<Start, Stop> fifo(4096);
+    ///     fifo.emplace<Stop>(1, "bye");
+    ///     Visitor visitor;
+    ///     fifo.consume(visitor);
+    ///
+    template<typename... Msgs> class MessageFIFO {
+
+        static_assert(sizeof...(Msgs) > 0, "MessageFIFO needs at least one message type");
+
+    protected:
+        std::unique_ptr<RecordFIFO> _ring;
+
+    public:
+        /// @param size: size of the ring in bytes
+        MessageFIFO(size_t size) : _ring(new RecordFIFO(size)) {}
+        virtual ~MessageFIFO() {
+            clear();
+        }
+
+    public:
+        /// Constructs a message in the FIFO. (Thread-safe)
+        ///
+        /// @param args: arguments forwarded to the constructor of Msg
+        /// @return Status::SUCCESS, Status::FULL or Status::ERROR if the
+        ///         message is bigger than the FIFO
+        template<typename Msg, typename... Args>
+        Status emplace(Args&&... args) {
+            return emplace_for<Msg>(0, std::forward<Args>(args)...);
+        }
+
+        /// Constructs a message in the FIFO. (Thread-safe)
+        ///
+        /// If the FIFO is full this function blocks until enough messages
+        /// are consumed or the timeout is reached.
+        ///
+        /// @param timeout: max amount of time to wait for room [ms]
+        /// @param args: arguments forwarded to the constructor of Msg
+        /// @return Status::SUCCESS, Status::TIMEOUT or Status::ERROR if the
+        ///         message is bigger than the FIFO
+        template<typename Msg, typename... Args>
+        Status emplace_for(unsigned timeout, Args&&... args) {
+            static_assert(alignof(Msg) <= RecordFIFO::ALIGNMENT, "over-aligned message type");
+            const uint16_t tag = msg_detail::index_of<Msg, Msgs...>::value;
+            RecordFIFO::Span span;
+            Status status = _ring->reserve(sizeof(Msg), span, timeout);
+            if(status != Status::SUCCESS)
+                return status;
+            try {
+                new (span.data) Msg(std::forward<Args>(args)...);
+            } catch(...) {
+                _ring->cancel();
+                throw;
+            }
+            _ring->commit(sizeof(Msg), tag);
+            return Status::SUCCESS;
+        }
+
+        /// Hands the oldest message to a visitor. (Thread-safe)
+        ///
+        /// If the fifo is empty this function blocks until new messages are
+        /// available. The visitor is called with a Msg& for the type of the
+        /// message, then the message is destroyed.
+        ///
+        /// @param visitor: callable with each of the types Msgs&...
+        /// @return no return
+        template<typename Visitor>
+        void consume(Visitor&& visitor) {
+            RecordFIFO::ConstSpan record;
+            _ring->read(record);
+            consume_helper(record, visitor);
+        }
+
+        /// Hands the oldest message to a visitor. (Thread-safe)
+        ///
+        /// If the fifo is empty this function blocks until new messages are
+        /// available or the timeout is reached.
+        ///
+        /// @param visitor: callable with each of the types Msgs&...
+        /// @param timeout: max amount of time to wait for a new message [ms]
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        template<typename Visitor>
+        Status consume(Visitor&& visitor, unsigned timeout) {
+            RecordFIFO::ConstSpan record;
+            if(_ring->read(record, timeout) != Status::SUCCESS)
+                return Status::TIMEOUT;
+            consume_helper(record, visitor);
+            return Status::SUCCESS;
+        }
+
+        /// Returns the current number of messages. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return current number of messages in the fifo
+        int size() {
+            return _ring->size();
+        }
+
+        /// Gets the size of the ring.
+        ///
+        /// @param no param
+        /// @return size of the ring in bytes
+        size_t get_max_size() {
+            return _ring->get_max_size();
+        }
+
+        /// Changes the size of the ring. (Not thread-safe)
+        ///
+        /// The queued messages are moved into the new ring. No other thread
+        /// may use the FIFO meanwhile.
+        ///
+        /// @param size: size of the ring in bytes
+        /// @return Status::SUCCESS or Status::FULL if the queued messages do
+        ///         not fit in the new size (nothing is changed then)
+        Status resize(size_t size) {
+            // moved in order into an empty ring the messages are packed
+            // without padding, so they fit if the bytes in use fit
+            std::unique_ptr<RecordFIFO> ring(new RecordFIFO(size));
+            if(ring->get_max_size() < _ring->size_bytes())
+                return Status::FULL;
+            RecordFIFO::ConstSpan record;
+            while(_ring->read(record, 0) == Status::SUCCESS) {
+                RecordFIFO::Span span;
+                ring->reserve(record.size, span);
+                void* msg = const_cast<char*>(record.data);
+                ops(record.tag).move(span.data, msg);
+                ops(record.tag).destroy(msg);
+                ring->commit(record.size, record.tag);
+                _ring->release();
+            }
+            _ring.swap(ring);
+            return Status::SUCCESS;
+        }
+
+        /// Destroys all the messages. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        void clear() {
+            RecordFIFO::ConstSpan record;
+            while(_ring->read(record, 0) == Status::SUCCESS) {
+                ops(record.tag).destroy(const_cast<char*>(record.data));
+                _ring->release();
+            }
+        }
+
+    protected:
+        static const msg_detail::Ops& ops(uint16_t tag) {
+            static const msg_detail::Ops table[] = {
+                { &msg_detail::destroy<Msgs>, &msg_detail::move<Msgs> }...
+            };
+            return table[tag];
+        }
+
+        template<typename Visitor>
+        void consume_helper(const RecordFIFO::ConstSpan& record, Visitor& visitor) {
+            using Visit = void (*)(void*, Visitor&);
+            static const Visit table[] = { &msg_detail::visit<Visitor, Msgs>... };
+            void* msg = const_cast<char*>(record.data);
+            try {
+                table[record.tag](msg, visitor);
+            } catch(...) {
+                ops(record.tag).destroy(msg);
+                _ring->release();
+                throw;
+            }
+            ops(record.tag).destroy(msg);
+            _ring->release();
+        }
+    };
+};
+
+#endif
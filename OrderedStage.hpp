@@ -0,0 +1,261 @@
+/*	=========================================================================
+	Company:
+	Filename: OrderedStage.hpp
+	Last modifed:   17.10.2026
+	Description:    Processing stage running a function on several worker
+                    threads while delivering the results in input order.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __ORDEREDSTAGE_HPP__
+#define __ORDEREDSTAGE_HPP__
+
+#include "FIFO.hpp"
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <utility>
+
+namespace tsFIFO {
+
+    /// Thread-safe ordered parallel map.
+    ///
+    /// The items pushed into the stage are numbered and processed by N
+    /// worker threads at the same time. Each result is written in the slot
+    /// of its number in a reorder ring, and pull() returns the results in
+    /// the order the items were pushed.
+    ///
+    /// The ring holds `window` results: when the oldest item is still being
+    /// processed and `window` items have been pushed after it, push() waits.
+    /// The slots of the ring are handed from the workers to the consumer
+    /// with an atomic state, no lock; the mutexes are used only to sleep.
+    ///
+    /// An exception thrown by the function is rethrown by pull() in place
+    /// of its result.
+    ///
+    /// Example usage:
+    ///
+    ///     tsFIFO::OrderedStage<std::unique_ptr<Frame>, std::unique_ptr<Packet>> stage(
+    ///         [](std::unique_ptr<Frame>& frame){ return encode(*frame); }, 8, 64); // 8 workers
+    ///     stage.push(frame);
+    ///     stage.pull(packet); // in the order of the frames
+    ///
+    template<typename In, typename Out> class OrderedStage {
+
+    protected:
+        enum State : int { EMPTY = 0, READY = 1 };
+
+        struct alignas(64) Slot : CacheAligned {
+            std::atomic<int>    _state;
+            Out                 _result;
+            std::exception_ptr  _error;
+        };
+
+        struct Job {
+            uint64_t    _seq;
+            In          _item;
+            bool        _stop;  ///< the worker exits
+        };
+
+        std::function<Out(In&)>         _function;
+        std::unique_ptr<Slot[]>         _ring;
+        uint64_t                        _window;
+        FIFO<Job, ActionIfFull::Nothing> _jobs;
+        std::vector<std::thread>        _workers;
+
+        uint64_t                        _next_in;       ///< number of the next item pushed
+        std::atomic<uint64_t>           _next_out;      ///< number of the next result pulled
+        std::atomic<int>                _producers_waiting;
+        std::atomic<int>                _consumers_waiting;
+        std::condition_variable         _condv_in;
+        std::mutex                      _mutex_in;
+        std::condition_variable         _condv_out;
+        std::mutex                      _mutex_out;
+
+    public:
+        /// @param function: transformation of an item into a result
+        /// @param workers: number of worker threads
+        /// @param window: max number of items in the stage
+        OrderedStage(std::function<Out(In&)> function, int workers, int window)
+            : _function(std::move(function)), _ring(new Slot[window]), _window(window),
+              _jobs(window + workers), _next_in(0), _next_out(0),
+              _producers_waiting(0), _consumers_waiting(0) {
+            for(uint64_t i=0; i<_window; ++i)
+                _ring[i]._state.store(EMPTY, std::memory_order_relaxed);
+            for(int i=0; i<workers; ++i)
+                _workers.emplace_back(&OrderedStage::worker, this);
+        }
+        virtual ~OrderedStage() {
+            for(size_t i=0; i<_workers.size(); ++i) {
+                Job job{0, In(), true};
+                _jobs.push(job);
+            }
+            for(std::thread& worker : _workers)
+                worker.join();
+        }
+
+        OrderedStage(const OrderedStage&) = delete;
+        OrderedStage& operator=(const OrderedStage&) = delete;
+
+    public:
+        /// Adds an item to process. (Thread-safe)
+        ///
+        /// If the reorder window is full this function blocks until the
+        /// oldest result is pulled.
+        ///
+        /// @param item: element to process
+        /// @return no return
+        void push(In& item) {
+            std::unique_lock<std::mutex> _lock(_mutex_in);
+            while(is_full_helper()) {
+                _producers_waiting.fetch_add(1);
+                if(is_full_helper())
+                    _condv_in.wait(_lock);
+                _producers_waiting.fetch_sub(1);
+            }
+            push_helper(item);
+        }
+
+        /// Adds an item to process. (Thread-safe)
+        ///
+        /// If the reorder window is full this function blocks until the
+        /// oldest result is pulled or the timeout is reached.
+        ///
+        /// @param item: element to process
+        /// @param timeout: max amount of time to wait for room [ms]
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status push(In& item, unsigned timeout) {
+            auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+            std::unique_lock<std::mutex> _lock(_mutex_in);
+            while(is_full_helper()) {
+                _producers_waiting.fetch_add(1);
+                bool expired = is_full_helper() && _condv_in.wait_until(_lock, until)==std::cv_status::timeout;
+                _producers_waiting.fetch_sub(1);
+                if(expired && is_full_helper())
+                    return Status::TIMEOUT;
+            }
+            push_helper(item);
+            return Status::SUCCESS;
+        }
+
+        /// Retrieves the next result in input order. (Thread-safe)
+        ///
+        /// If the result is not ready this function blocks until it is.
+        ///
+        /// @param result: the result of the oldest item
+        /// @return no return
+        void pull(Out& result) {
+            std::unique_lock<std::mutex> _lock(_mutex_out);
+            // another consumer may take the slot while this one sleeps
+            while(next_slot()._state.load(std::memory_order_acquire) != READY) {
+                _consumers_waiting.fetch_add(1);
+                if(next_slot()._state.load() != READY)
+                    _condv_out.wait(_lock);
+                _consumers_waiting.fetch_sub(1);
+            }
+            pull_helper(next_slot(), result);
+        }
+
+        /// Retrieves the next result in input order. (Thread-safe)
+        ///
+        /// If the result is not ready this function blocks until it is or
+        /// the timeout is reached.
+        ///
+        /// @param result: the result of the oldest item
+        /// @param timeout: max amount of time to wait for the result [ms]
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status pull(Out& result, unsigned timeout) {
+            auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+            std::unique_lock<std::mutex> _lock(_mutex_out);
+            while(next_slot()._state.load(std::memory_order_acquire) != READY) {
+                _consumers_waiting.fetch_add(1);
+                bool expired = next_slot()._state.load() != READY && _condv_out.wait_until(_lock, until)==std::cv_status::timeout;
+                _consumers_waiting.fetch_sub(1);
+                if(expired && next_slot()._state.load(std::memory_order_acquire) != READY)
+                    return Status::TIMEOUT;
+            }
+            pull_helper(next_slot(), result);
+            return Status::SUCCESS;
+        }
+
+        /// Returns the number of items pushed and not pulled yet. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return number of items in the stage
+        int size() {
+            std::unique_lock<std::mutex> _lock(_mutex_in);
+            return _next_in - _next_out.load();
+        }
+
+        /// Gets the size of the reorder window.
+        ///
+        /// @param no param
+        /// @return max number of items in the stage
+        int get_max_size() const {
+            return _window;
+        }
+
+    protected:
+        /// Slot of the next result, the output mutex must be locked
+        Slot& next_slot() {
+            return _ring[_next_out.load(std::memory_order_relaxed) % _window];
+        }
+
+        bool is_full_helper() {
+            return _next_in - _next_out.load() >= _window;
+        }
+
+        void push_helper(In& item) {
+            Job job{_next_in++, std::move(item), false};
+            _jobs.push(job);
+        }
+
+        void pull_helper(Slot& slot, Out& result) {
+            std::exception_ptr error = slot._error;
+            slot._error = nullptr;
+            result = std::move(slot._result);
+            slot._state.store(EMPTY, std::memory_order_relaxed);
+            _next_out.fetch_add(1);
+            // the slot is free, a producer may be waiting for it
+            if(_producers_waiting.load() > 0) {
+                std::unique_lock<std::mutex> _lock(_mutex_in);
+                _condv_in.notify_one();
+            }
+            if(error)
+                std::rethrow_exception(error);
+        }
+
+        void worker() {
+            for(;;) {
+                Job job;
+                _jobs.pull(job);
+                if(job._stop)
+                    break;
+                Slot& slot = _ring[job._seq % _window];
+                try {
+                    slot._result = _function(job._item);
+                } catch(...) {
+                    slot._error = std::current_exception();
+                }
+                slot._state.store(READY);
+                // wake the consumer if it waits, maybe for this result
+                if(_consumers_waiting.load() > 0) {
+                    std::unique_lock<std::mutex> _lock(_mutex_out);
+                    _condv_out.notify_all();
+                }
+            }
+        }
+    };
+};
+
+#endif
@@ -0,0 +1,368 @@
+/*	=========================================================================
+	Company:
+	Filename: PartitionedFIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Thread-safe FIFO split into lanes by key. Each lane is
+                    leased to one consumer at a time so that the items with
+                    the same key are processed in order.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __PARTITIONEDFIFO_HPP__
+#define __PARTITIONEDFIFO_HPP__
+
+#include "FIFO.hpp"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+namespace tsFIFO {
+
+    // Default key extractor: the items expose their key via get_key()
+    struct GetKey {
+        template<typename T>
+        auto operator()(T& item) const -> decltype(item->get_key()) {
+            return item->get_key();
+        }
+    };
+
+    /// Thread-safe FIFO partitioned by key.
+    ///
+    /// The key of an item, given by the key extractor, is hashed to one of
+    /// P lanes. A consumer acquires the lease of a non-empty lane that no
+    /// other consumer holds, pulls from it, and releases it. As a lane is
+    /// processed by one consumer at a time the items with the same key are
+    /// processed in the order they were pushed, and up to P consumers run
+    /// in parallel.
+    ///
+    /// Every lane has its own mutex: there is no lock shared by all the
+    /// producers and consumers. The leases are atomic flags. Only the idle
+    /// consumers share a mutex to sleep on, and the producers touch it
+    /// only when a consumer is actually sleeping.
+    ///
+    /// Example usage:
+    ///
+    ///     tsFIFO::PartitionedFIFO<std::unique_ptr<Order>> fifo(16, 1000); // 16 lanes
+    ///     fifo.push(order); // lane of order->get_key()
+    ///
+    ///     // consumer thread
+    ///     auto lease = fifo.acquire();
+    ///     while( lease.pull(order) == tsFIFO::Status::SUCCESS )
+    ///         process(order);
+    ///     lease.release(); // or when lease goes out of scope
+    ///
+    template <  typename T,
+                ActionIfFull action_if_full = ActionIfFull::DumpFirstEntry,
+                typename KeyExtractor = GetKey> class PartitionedFIFO {
+
+    public:
+        using Key = typename std::decay<decltype(std::declval<KeyExtractor&>()(std::declval<T&>()))>::type;
+
+    protected:
+        /// One lane per cache line, the producers of different lanes do not
+        /// share anything.
+        struct alignas(64) Lane : CacheAligned {
+            std::queue<T>           _queue;
+            int                     _max_size;
+            std::atomic<int>        _size;
+            std::atomic<bool>       _leased;
+            std::condition_variable _condv; ///< the lease holder waiting for items
+            std::mutex              _mutex;
+        };
+
+    public:
+        /// Exclusive right to pull from a lane. Movable, released when destroyed.
+        class Lease {
+
+            friend class PartitionedFIFO;
+
+        private:
+            PartitionedFIFO*    _fifo;
+            int                 _lane;
+
+            Lease(PartitionedFIFO* fifo, int lane) : _fifo(fifo), _lane(lane) {}
+
+        public:
+            Lease() : _fifo(nullptr), _lane(-1) {}
+            Lease(const Lease&) = delete;
+            Lease& operator=(const Lease&) = delete;
+            Lease(Lease&& other) : _fifo(other._fifo), _lane(other._lane) {
+                other._fifo = nullptr;
+            }
+            Lease& operator=(Lease&& other) {
+                if(this != &other) {
+                    release();
+                    _fifo = other._fifo;
+                    _lane = other._lane;
+                    other._fifo = nullptr;
+                }
+                return *this;
+            }
+            ~Lease() {
+                release();
+            }
+
+            explicit operator bool() const { return _fifo != nullptr; }
+
+            /// Gets the leased lane.
+            ///
+            /// @param no param
+            /// @return index of the lane
+            int lane() const { return _lane; }
+
+            /// Retrieves an item from the leased lane. (Thread-safe)
+            ///
+            /// The oldest element of the lane is pulled. If the lane is empty
+            /// this function blocks until new data are available or the
+            /// timeout is reached.
+            ///
+            /// @param item: element pulled from the lane
+            /// @param timeout: max amount of time to wait for a new item [ms], 0 by default
+            /// @return either Status::TIMEOUT or Status::SUCCESS
+            Status pull(T& item, unsigned timeout = 0) {
+                Lane& lane = *_fifo->_lanes[_lane];
+                std::unique_lock<std::mutex> _lock(lane._mutex);
+                while(lane._queue.empty()) {
+                    if(timeout == 0 || lane._condv.wait_for(_lock, std::chrono::milliseconds(timeout))==std::cv_status::timeout)
+                        return Status::TIMEOUT;
+                }
+                item = pull_pop_first(lane);
+                return Status::SUCCESS;
+            }
+
+            /// Gives the lane back to the other consumers. (Thread-safe)
+            ///
+            /// @param no param
+            /// @return no return
+            void release() {
+                if(!_fifo)
+                    return;
+                Lane& lane = *_fifo->_lanes[_lane];
+                lane._leased.store(false);
+                // the items left are for another consumer
+                if(lane._size.load() > 0)
+                    _fifo->wake_idle_helper();
+                _fifo = nullptr;
+            }
+        };
+
+    protected:
+        std::vector<std::unique_ptr<Lane>> _lanes;
+        KeyExtractor            _key_of;
+        std::hash<Key>          _hash;
+        std::atomic<unsigned>   _cursor;    ///< where the next search for a lane starts
+        std::atomic<int>        _sleepers;  ///< consumers waiting for a lane
+        std::condition_variable _condv;
+        std::mutex              _mutex;     ///< for the idle consumers only
+
+    public:
+        /// @param lanes: number of lanes, the max number of parallel consumers
+        /// @param lane_size: max number of items of each lane
+        PartitionedFIFO(int lanes, int lane_size, KeyExtractor key_of = KeyExtractor())
+            : _key_of(key_of), _cursor(0), _sleepers(0) {
+            for(int i=0; i<lanes; ++i) {
+                _lanes.emplace_back(new Lane());
+                _lanes.back()->_max_size = lane_size;
+                _lanes.back()->_size.store(0);
+                _lanes.back()->_leased.store(false);
+            }
+        }
+        virtual ~PartitionedFIFO() {
+            clear();
+        }
+
+    public:
+        /// Adds an item into the lane of its key. (Thread-safe)
+        ///
+        /// If the lane is full ActionIfFull defines the action to undertake.
+        ///
+        /// @param item: element to push into the fifo
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push(T& item) {
+            Lane& lane = *_lanes[lane_of(_key_of(item))];
+            {
+                std::unique_lock<std::mutex> _lock(lane._mutex);
+                if(static_cast<int>(lane._queue.size()) >= lane._max_size) {
+                    if(action_if_full == ActionIfFull::DumpFirstEntry && !lane._queue.empty()) {
+                        T first = pull_pop_first(lane); // dump the the oldest item
+                        clear_helper(first);
+                        push_last(lane, item); // add the new one
+                    }
+                    return Status::FULL;
+                }
+                push_last(lane, item);
+            }
+            lane._condv.notify_one();
+            if(!lane._leased.load())
+                wake_idle_helper();
+            return Status::SUCCESS;
+        }
+
+        /// Leases a non-empty lane that no other consumer holds. (Thread-safe)
+        ///
+        /// This function blocks until such a lane is available.
+        ///
+        /// @param no param
+        /// @return the lease
+        Lease acquire() {
+            Lease lease;
+            int lane = try_acquire_helper();
+            if(lane < 0) {
+                std::unique_lock<std::mutex> _lock(_mutex);
+                _sleepers.fetch_add(1);
+                while((lane = try_acquire_helper()) < 0)
+                    _condv.wait(_lock);
+                _sleepers.fetch_sub(1);
+            }
+            return Lease(this, lane);
+        }
+
+        /// Leases a non-empty lane that no other consumer holds. (Thread-safe)
+        ///
+        /// This function blocks until such a lane is available or the
+        /// timeout is reached.
+        ///
+        /// @param lease: the lease, empty on timeout
+        /// @param timeout: max amount of time to wait for a lane [ms]
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status acquire(Lease& lease, unsigned timeout) {
+            int lane = try_acquire_helper();
+            if(lane < 0) {
+                auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+                std::unique_lock<std::mutex> _lock(_mutex);
+                _sleepers.fetch_add(1);
+                while((lane = try_acquire_helper()) < 0) {
+                    if(_condv.wait_until(_lock, until)==std::cv_status::timeout) {
+                        lane = try_acquire_helper();
+                        break;
+                    }
+                }
+                _sleepers.fetch_sub(1);
+            }
+            if(lane < 0) {
+                lease = Lease();
+                return Status::TIMEOUT;
+            }
+            lease = Lease(this, lane);
+            return Status::SUCCESS;
+        }
+
+        /// Gets the lane of a key.
+        ///
+        /// @param key: the key
+        /// @return index of the lane
+        int lane_of(const Key& key) const {
+            return _hash(key) % _lanes.size();
+        }
+
+        /// Gets the number of lanes.
+        ///
+        /// @param no param
+        /// @return number of lanes
+        int lanes() const {
+            return _lanes.size();
+        }
+
+        /// Returns the current number of items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return current number of items in the fifo, a snapshot
+        int size() {
+            int size = 0;
+            for(auto& lane : _lanes)
+                size += lane->_size.load(std::memory_order_relaxed);
+            return size;
+        }
+
+        /// Deletes all the items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        void clear() {
+            for(auto& lane : _lanes) {
+                std::unique_lock<std::mutex> _lock(lane->_mutex);
+                while(!lane->_queue.empty()) {
+                    T item = pull_pop_first(*lane);
+                    // For C-style pointers, clear_helper() calls delete.
+                    clear_helper(item);
+                }
+            }
+        }
+
+    protected:
+        /// Gets the first item of a lane then pop it, the lane mutex must be locked
+        ///
+        /// @param lane: the lane
+        /// @return the item
+        static T pull_pop_first(Lane& lane) {
+            T item = std::move(lane._queue.front());
+            lane._queue.pop();
+            lane._size.fetch_sub(1, std::memory_order_relaxed);
+            return item;
+        }
+
+        /// Add item into a lane, the lane mutex must be locked
+        ///
+        /// @param lane: the lane
+        /// @param item: the item to add
+        /// @return no return
+        static void push_last(Lane& lane, T& item) {
+            lane._queue.push(std::move(item));
+            lane._size.fetch_add(1);
+        }
+
+        /// Takes the lease of the first free non-empty lane.
+        ///
+        /// Called with or without _mutex locked: it must not wake anybody.
+        ///
+        /// @param no param
+        /// @return index of the lane or -1
+        int try_acquire_helper() {
+            const unsigned n = _lanes.size();
+            const unsigned start = _cursor.fetch_add(1, std::memory_order_relaxed);
+            for(unsigned i=0; i<n; ++i) {
+                unsigned index = (start + i) % n;
+                Lane& lane = *_lanes[index];
+                while(lane._size.load() > 0 && !lane._leased.load()) {
+                    bool expected = false;
+                    if(lane._leased.compare_exchange_strong(expected, true)) {
+                        if(lane._size.load() > 0)
+                            return index;
+                        // emptied meanwhile by the previous holder; a producer
+                        // refilling it now saw the lease and woke nobody:
+                        // the test of the loop retries it
+                        lane._leased.store(false);
+                    }
+                }
+            }
+            return -1;
+        }
+
+        /// Wakes an idle consumer, if any.
+        ///
+        /// The consumers count themselves before searching a lane, the
+        /// producers count the items before checking for consumers: either
+        /// the consumer finds the item or the producer finds the consumer.
+        ///
+        /// @param no param
+        /// @return no return
+        void wake_idle_helper() {
+            if(_sleepers.load() > 0) {
+                std::unique_lock<std::mutex> _lock(_mutex);
+                _condv.notify_one();
+            }
+        }
+    };
+};
+
+#endif
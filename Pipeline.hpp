@@ -0,0 +1,528 @@
+/*	=========================================================================
+	Company:
+	Filename: Pipeline.hpp
+	Last modifed:   17.10.2026
+	Description:    Builder of a chain of threads connected by bounded
+                    queues: source >> stage >> ... >> sink, with
+                    backpressure, clean shutdown and statistics.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __PIPELINE_HPP__
+#define __PIPELINE_HPP__
+
+#include "FIFO.hpp"
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <vector>
+#include <string>
+#include <thread>
+#include <memory>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <utility>
+#include <type_traits>
+
+namespace tsFIFO {
+
+    /// Queue between two nodes of a Pipeline, as seen by the pipeline.
+    class EdgeBase {
+        public:
+            virtual ~EdgeBase() {}
+            virtual void close() = 0;
+            virtual int size() = 0;
+            virtual int get_max_size() const = 0;
+    };
+
+    /// Bounded queue between two nodes of a Pipeline. (Thread-safe)
+    ///
+    /// push() blocks while the edge is full: a slow stage slows down the
+    /// stages before it, up to the source. Once closed the edge refuses
+    /// the new items and pull() returns the items left, then false.
+    template<typename T> class Edge : public EdgeBase {
+
+    protected:
+        std::queue<T>           _queue;
+        int                     _max_size;
+        bool                    _closed;
+        std::condition_variable _condv_data;
+        std::condition_variable _condv_room;
+        std::mutex              _mutex;
+
+    public:
+        Edge(int size) : _max_size(size > 0 ? size : 1), _closed(false) {}
+
+        /// Adds an item, waits while the edge is full. (Thread-safe)
+        ///
+        /// @param item: element to push into the edge
+        /// @return false if the edge is closed, the item is then left untouched
+        bool push(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(static_cast<int>(_queue.size()) >= _max_size && !_closed) {
+                _condv_room.wait(_lock);
+            }
+            if(_closed)
+                return false;
+            _queue.push(std::move(item));
+            _condv_data.notify_one();
+            return true;
+        }
+
+        /// Retrieves the oldest item, waits while the edge is empty. (Thread-safe)
+        ///
+        /// @param item: element pulled from the edge
+        /// @return false if the edge is closed and empty
+        bool pull(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(_queue.empty() && !_closed) {
+                _condv_data.wait(_lock);
+            }
+            if(_queue.empty())
+                return false;
+            item = std::move(_queue.front());
+            _queue.pop();
+            _condv_room.notify_one();
+            return true;
+        }
+
+        /// Refuses the new items, the items left can still be pulled. (Thread-safe)
+        void close() override {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            _closed = true;
+            _condv_data.notify_all();
+            _condv_room.notify_all();
+        }
+
+        int size() override {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _queue.size();
+        }
+
+        int get_max_size() const override {
+            return _max_size;
+        }
+    };
+
+    /// Statistics of a node of a Pipeline.
+    struct StageStats {
+        std::string _name;
+        int         _workers;
+        uint64_t    _processed;     ///< items processed
+        uint64_t    _errors;        ///< items dropped because the function threw
+        int         _depth;         ///< items waiting in the input edge
+        int         _capacity;      ///< max size of the input edge
+        double      _throughput;    ///< items processed per second since start()
+    };
+
+    template<typename T, typename F> struct SourceSpec {
+        F   _function;
+    };
+
+    template<typename F> struct StageSpec {
+        F   _function;
+        int _workers;
+        int _capacity;
+    };
+
+    template<typename F> struct SinkSpec {
+        F   _function;
+        int _workers;
+        int _capacity;
+    };
+
+    /// Source of a pipeline: function(T& item) fills an item and returns
+    /// true, or returns false when there is no more item.
+    template<typename T, typename F>
+    SourceSpec<T, F> source(F function) {
+        return SourceSpec<T, F>{std::move(function)};
+    }
+
+    /// Stage of a pipeline: function(In& item) returns the item for the next
+    /// stage. With several workers the order of the items is not kept.
+    ///
+    /// @param function: the transformation
+    /// @param workers: number of threads running the function
+    /// @param capacity: max number of items waiting for the stage
+    template<typename F>
+    StageSpec<F> stage(F function, int workers = 4, int capacity = 64) {
+        return StageSpec<F>{std::move(function), workers, capacity};
+    }
+
+    /// Sink of a pipeline: function(T& item) consumes the item.
+    ///
+    /// @param function: the consumer
+    /// @param workers: number of threads running the function
+    /// @param capacity: max number of items waiting for the sink
+    template<typename F>
+    SinkSpec<F> sink(F function, int workers = 1, int capacity = 64) {
+        return SinkSpec<F>{std::move(function), workers, capacity};
+    }
+
+    template<typename F> struct FuseSpec {
+        F   _function;
+    };
+
+    /// Fusible stage of a pipeline: function(In& item) returns the item for
+    /// the next stage, as stage(), but without its own threads and input
+    /// edge. It is composed at compile time with the fusible stages that
+    /// follow it and with the next stage() or sink(), and runs inlined on
+    /// the threads of the latter. Meant for the cheap transforms, for which
+    /// an edge costs more than the work.
+    ///
+    /// @param function: the transformation
+    template<typename F>
+    FuseSpec<F> fuse(F function) {
+        return FuseSpec<F>{std::move(function)};
+    }
+
+    /// Composition of two functions: second(first(item)).
+    template<typename F, typename G> struct Fused {
+        F   _first;
+        G   _second;
+
+        template<typename In>
+        auto operator()(In& item) {
+            auto middle = _first(item);
+            return _second(middle);
+        }
+    };
+
+    template<typename T> class PipelineBuilder;
+    template<typename T, typename G> class FusedBuilder;
+
+    /// Chain of threads connected by bounded edges.
+    ///
+    /// A pipeline is built with operator>> from a source, stages and a
+    /// sink. Each stage runs its function on its own worker threads and
+    /// has its own input edge; push() into a full edge blocks, so the
+    /// backpressure goes up to the source. When the source is exhausted,
+    /// or close() is called, the edges are closed one after the other:
+    /// each stage drains its input, then closes its output once its last
+    /// worker is done. An exception thrown by a function drops the item,
+    /// closes the pipeline and is rethrown by wait().
+    ///
+    /// The stages given by fuse() have neither threads nor edge: they are
+    /// composed with the next stage or sink, whose node they are part of
+    /// in stats(). An edge is then only where a stage() or a sink() asks
+    /// for its own threads, for parallelism or for blocking I/O.
+    ///
+    /// Example usage:
+    ///
+    ///     tsFIFO::Pipeline pipeline = tsFIFO::source<Frame>(capture)
+    ///         >> tsFIFO::fuse([](Frame& frame){ return crop(frame); })         // on the encoder threads
+    ///         >> tsFIFO::stage([](Frame& frame){ return encode(frame); }, 4, 64) // 4 workers
+    ///         >> tsFIFO::sink([](Packet& packet){ send(packet); });
+    ///     pipeline.start();
+    ///     ...
+    ///     pipeline.close(); // the items in flight are processed
+    ///     pipeline.wait();
+    ///
+    class Pipeline {
+
+        template<typename T> friend class PipelineBuilder;
+
+    protected:
+        struct Graph;
+
+        /// A source, a stage or a sink.
+        struct Node {
+            std::string                 _name;
+            int                         _workers;
+            std::function<void(Node&)>  _body;      ///< run by each worker
+            EdgeBase*                   _input;
+            EdgeBase*                   _output;
+            Graph*                      _graph;
+            std::atomic<int>            _running;   ///< workers not done yet
+            std::atomic<uint64_t>       _processed;
+            std::atomic<uint64_t>       _errors;
+        };
+
+        struct Graph {
+            std::vector<std::unique_ptr<Node>>      _nodes;
+            std::vector<std::unique_ptr<EdgeBase>>  _edges;
+            std::vector<std::thread>                _threads;
+            std::chrono::steady_clock::time_point   _start;
+            std::exception_ptr                      _error;
+            std::mutex                              _mutex;
+
+            /// Records the first error and closes the pipeline.
+            void fail(std::exception_ptr error) {
+                {
+                    std::unique_lock<std::mutex> _lock(_mutex);
+                    if(!_error)
+                        _error = error;
+                }
+                if(!_edges.empty())
+                    _edges.front()->close();
+            }
+        };
+
+        std::unique_ptr<Graph>  _graph;
+
+        Pipeline(std::unique_ptr<Graph> graph) : _graph(std::move(graph)) {}
+
+    public:
+        Pipeline(Pipeline&&) = default;
+        Pipeline& operator=(Pipeline&&) = default;
+        virtual ~Pipeline() {
+            if(_graph && !_graph->_threads.empty()) {
+                close();
+                join_helper();
+            }
+        }
+
+        /// Starts the threads of all the nodes.
+        ///
+        /// @param no param
+        /// @return no return
+        void start() {
+            _graph->_start = std::chrono::steady_clock::now();
+            for(std::unique_ptr<Node>& node : _graph->_nodes) {
+                node->_running.store(node->_workers);
+                for(int i=0; i<node->_workers; ++i) {
+                    Node* n = node.get();
+                    _graph->_threads.emplace_back([n](){
+                        n->_body(*n);
+                        // the last worker closes the output, the next node drains it
+                        if(n->_running.fetch_sub(1) == 1 && n->_output)
+                            n->_output->close();
+                    });
+                }
+            }
+        }
+
+        /// Stops the source; the items already in the pipeline are
+        /// processed. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no return
+        void close() {
+            if(!_graph->_edges.empty())
+                _graph->_edges.front()->close();
+        }
+
+        /// Waits until all the nodes are done.
+        ///
+        /// @param no param
+        /// @return no return, rethrows the first exception thrown by a function
+        void wait() {
+            join_helper();
+            if(_graph->_error)
+                std::rethrow_exception(_graph->_error);
+        }
+
+        /// Starts the pipeline and waits until the source is exhausted
+        /// and all the items are processed.
+        ///
+        /// @param no param
+        /// @return no return, rethrows the first exception thrown by a function
+        void run() {
+            start();
+            wait();
+        }
+
+        /// Returns the statistics of the nodes, source first. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return one entry per node
+        std::vector<StageStats> stats() {
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - _graph->_start).count();
+            std::vector<StageStats> stats;
+            for(std::unique_ptr<Node>& node : _graph->_nodes) {
+                uint64_t processed = node->_processed.load(std::memory_order_relaxed);
+                stats.push_back(StageStats{node->_name, node->_workers, processed,
+                                           node->_errors.load(std::memory_order_relaxed),
+                                           node->_input ? node->_input->size() : 0,
+                                           node->_input ? node->_input->get_max_size() : 0,
+                                           seconds > 0 ? processed / seconds : 0.0});
+            }
+            return stats;
+        }
+
+    protected:
+        void join_helper() {
+            for(std::thread& thread : _graph->_threads)
+                thread.join();
+            _graph->_threads.clear();
+        }
+    };
+
+    /// Pipeline under construction whose last node outputs items of type T.
+    template<typename T> class PipelineBuilder {
+
+        template<typename U> friend class PipelineBuilder;
+
+    protected:
+        using Node = Pipeline::Node;
+        using Graph = Pipeline::Graph;
+
+        std::unique_ptr<Graph>          _graph;
+        std::function<void(Edge<T>*)>   _connect;   ///< gives its output edge to the last node
+
+    public:
+        template<typename F>
+        PipelineBuilder(SourceSpec<T, F> spec) : _graph(new Graph()) {
+            Node* node = add_node_helper("source", 1, nullptr);
+            F function = std::move(spec._function);
+            _connect = [node, function](Edge<T>* output) {
+                node->_output = output;
+                node->_body = [function, output](Node& node) mutable {
+                    T item;
+                    for(;;) {
+                        try {
+                            if(!function(item))
+                                break;
+                        } catch(...) {
+                            node._errors.fetch_add(1, std::memory_order_relaxed);
+                            node._graph->fail(std::current_exception());
+                            break;
+                        }
+                        if(!output->push(item))
+                            break;
+                        node._processed.fetch_add(1, std::memory_order_relaxed);
+                        item = T();
+                    }
+                };
+            };
+        }
+
+        /// Appends a fusible stage, it is materialized with the next
+        /// stage or sink.
+        template<typename F>
+        FusedBuilder<T, F> operator>>(FuseSpec<F> spec) && {
+            return FusedBuilder<T, F>(std::move(*this), std::move(spec._function));
+        }
+
+        /// Appends a stage.
+        template<typename F>
+        auto operator>>(StageSpec<F> spec) && {
+            using Out = typename std::decay<decltype(std::declval<F&>()(std::declval<T&>()))>::type;
+            Edge<T>* input = add_edge_helper(spec._capacity);
+            Node* node = add_node_helper("stage " + std::to_string(_graph->_nodes.size()), spec._workers, input);
+            PipelineBuilder<Out> next(std::move(_graph));
+            F function = std::move(spec._function);
+            next._connect = [node, input, function](Edge<Out>* output) {
+                node->_output = output;
+                node->_body = [function, input, output](Node& node) mutable {
+                    T item;
+                    while(input->pull(item)) {
+                        try {
+                            Out result = function(item);
+                            node._processed.fetch_add(1, std::memory_order_relaxed);
+                            output->push(result);
+                        } catch(...) {
+                            node._errors.fetch_add(1, std::memory_order_relaxed);
+                            node._graph->fail(std::current_exception());
+                        }
+                    }
+                };
+            };
+            return next;
+        }
+
+        /// Appends the sink, the pipeline is complete.
+        template<typename F>
+        Pipeline operator>>(SinkSpec<F> spec) && {
+            Edge<T>* input = add_edge_helper(spec._capacity);
+            Node* node = add_node_helper("sink", spec._workers, input);
+            F function = std::move(spec._function);
+            node->_body = [function, input](Node& node) mutable {
+                T item;
+                while(input->pull(item)) {
+                    try {
+                        function(item);
+                        node._processed.fetch_add(1, std::memory_order_relaxed);
+                    } catch(...) {
+                        node._errors.fetch_add(1, std::memory_order_relaxed);
+                        node._graph->fail(std::current_exception());
+                    }
+                }
+            };
+            return Pipeline(std::move(_graph));
+        }
+
+    protected:
+        PipelineBuilder(std::unique_ptr<Graph> graph) : _graph(std::move(graph)) {}
+
+        /// Creates the input edge of the next node and connects the last
+        /// node to it.
+        Edge<T>* add_edge_helper(int capacity) {
+            Edge<T>* edge = new Edge<T>(capacity);
+            _graph->_edges.emplace_back(edge);
+            _connect(edge);
+            return edge;
+        }
+
+        Node* add_node_helper(const std::string& name, int workers, EdgeBase* input) {
+            Node* node = new Node();
+            node->_name = name;
+            node->_workers = workers > 0 ? workers : 1;
+            node->_input = input;
+            node->_output = nullptr;
+            node->_graph = _graph.get();
+            node->_running.store(0);
+            node->_processed.store(0);
+            node->_errors.store(0);
+            _graph->_nodes.emplace_back(node);
+            return node;
+        }
+    };
+
+    /// Pipeline under construction followed by fusible stages: function(T& item)
+    /// is their composition, not materialized yet.
+    template<typename T, typename G> class FusedBuilder {
+
+    protected:
+        PipelineBuilder<T>  _builder;
+        G                   _function;
+
+    public:
+        FusedBuilder(PipelineBuilder<T>&& builder, G function)
+            : _builder(std::move(builder)), _function(std::move(function)) {}
+
+        /// Composes one more fusible stage.
+        template<typename F>
+        FusedBuilder<T, Fused<G, F>> operator>>(FuseSpec<F> spec) && {
+            return FusedBuilder<T, Fused<G, F>>(std::move(_builder),
+                                                Fused<G, F>{std::move(_function), std::move(spec._function)});
+        }
+
+        /// Appends a stage running the fusible stages before its own function.
+        template<typename F>
+        auto operator>>(StageSpec<F> spec) && {
+            return std::move(_builder) >> stage(Fused<G, F>{std::move(_function), std::move(spec._function)},
+                                                spec._workers, spec._capacity);
+        }
+
+        /// Appends the sink running the fusible stages before its own function.
+        template<typename F>
+        Pipeline operator>>(SinkSpec<F> spec) && {
+            return std::move(_builder) >> sink(Fused<G, F>{std::move(_function), std::move(spec._function)},
+                                               spec._workers, spec._capacity);
+        }
+    };
+
+    template<typename T, typename F, typename G>
+    FusedBuilder<T, G> operator>>(SourceSpec<T, F> source, FuseSpec<G> fused) {
+        return PipelineBuilder<T>(std::move(source)) >> std::move(fused);
+    }
+
+    template<typename T, typename F, typename G>
+    auto operator>>(SourceSpec<T, F> source, StageSpec<G> stage) {
+        return PipelineBuilder<T>(std::move(source)) >> std::move(stage);
+    }
+
+    template<typename T, typename F, typename G>
+    Pipeline operator>>(SourceSpec<T, F> source, SinkSpec<G> sink) {
+        return PipelineBuilder<T>(std::move(source)) >> std::move(sink);
+    }
+};
+
+#endif
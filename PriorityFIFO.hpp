@@ -0,0 +1,271 @@
+/*	=========================================================================
+	Company:
+	Filename: PriorityFIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Thread-safe FIFO with several priority levels. The
+                    highest non-empty level is found from a bitmap.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __PRIORITYFIFO_HPP__
+#define __PRIORITYFIFO_HPP__
+
+#include "FIFO.hpp"
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <array>
+#include <chrono>
+
+namespace tsFIFO {
+
+    /// Thread-safe FIFO with Levels priority levels.
+    ///
+    /// Level 0 is the highest priority. Each level is a FIFO with its own
+    /// max size and ActionIfFull. A bitmap has one bit per non-empty level,
+    /// pull() takes the oldest item of the highest non-empty level with a
+    /// single count-trailing-zeros.
+    ///
+    /// To avoid starvation of the low levels an aging period can be set:
+    /// a non-empty level not served for that many pulls is served next,
+    /// whatever its priority.
+    ///
+    /// Example usage:
+    ///
+    ///     enum { CONTROL = 0, BULK = 1 };
+    ///     tsFIFO::PriorityFIFO<std::unique_ptr<Message>, 2> fifo(100);
+    ///     fifo.set_level(BULK, 10000, tsFIFO::ActionIfFull::Nothing);
+    ///     fifo.set_aging(1000); // at least one bulk message every 1000 pulls
+    ///     fifo.push(data, BULK);
+    ///     fifo.push(stop, CONTROL);
+    ///     fifo.pull(msg); // stop
+    ///
+    template<typename T, unsigned Levels = 8> class PriorityFIFO {
+
+        static_assert(Levels > 0 && Levels <= 64, "PriorityFIFO supports 1 to 64 levels");
+
+    protected:
+        struct Level {
+            std::queue<T>   _queue;
+            int             _max_size;
+            ActionIfFull    _action;
+            uint64_t        _served_at; ///< pull count when last served or filled
+        };
+
+        std::array<Level, Levels>   _levels;
+        std::atomic<uint64_t>       _bitmap;    ///< bit i is set if level i is not empty
+        uint64_t                    _pulls;
+        uint64_t                    _aging;     ///< 0 to disable
+        std::condition_variable     _condv;
+        std::mutex                  _mutex;
+
+    public:
+        PriorityFIFO() : PriorityFIFO(0) {}
+        /// @param size: max number of items of each level
+        /// @param action: action of each level when it is full
+        PriorityFIFO(int size, ActionIfFull action = ActionIfFull::DumpFirstEntry)
+            : _bitmap(0), _pulls(0), _aging(0) {
+            for(Level& level : _levels) {
+                level._max_size = size;
+                level._action = action;
+                level._served_at = 0;
+            }
+        }
+        virtual ~PriorityFIFO() {
+            clear();
+        }
+
+    public:
+        /// Adds an item into a level of the FIFO. (Thread-safe)
+        ///
+        /// If the level is full its ActionIfFull defines the action to undertake.
+        ///
+        /// @param item: element to push into the fifo
+        /// @param level: priority of the item, 0 is the highest
+        /// @return Status::FULL, Status::SUCCESS or Status::ERROR if there is no such level
+        Status push(T& item, unsigned level) {
+            if(level >= Levels)
+                return Status::ERROR;
+            std::unique_lock<std::mutex> _lock(_mutex);
+            Level& l = _levels[level];
+            if(static_cast<int>(l._queue.size()) >= l._max_size) {
+                if(l._action == ActionIfFull::DumpFirstEntry && !l._queue.empty()) {
+                    T first = std::move(l._queue.front()); // dump the the oldest item
+                    l._queue.pop();
+                    clear_helper(first);
+                    l._queue.push(std::move(item)); // add the new one
+                }
+                return Status::FULL;
+            }
+            if(l._queue.empty()) {
+                // the level starts aging now
+                l._served_at = _pulls;
+                _bitmap.fetch_or(uint64_t(1) << level, std::memory_order_relaxed);
+            }
+            l._queue.push(std::move(item));
+            _condv.notify_one();
+            return Status::SUCCESS;
+        }
+
+        /// Retrieves an item from the FIFO. (Thread-safe)
+        ///
+        /// The oldest element of the highest non-empty level is pulled. If
+        /// the fifo is empty this function blocks until new data are available.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @return no return
+        void pull(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(_bitmap.load(std::memory_order_relaxed) == 0) {
+                _condv.wait(_lock);
+            }
+            item = pull_pop_first();
+        }
+
+        /// Retrieves an item from the FIFO. (Thread-safe)
+        ///
+        /// The oldest element of the highest non-empty level is pulled. If
+        /// the fifo is empty this function blocks until new data are available
+        /// or the timeout is reached.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @param timeout: an integer defining the max amount of time to wait for a new item
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status pull(T& item, unsigned timeout) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(_bitmap.load(std::memory_order_relaxed) == 0) {
+                if(_condv.wait_for(_lock, std::chrono::milliseconds(timeout))==std::cv_status::timeout)
+                    return Status::TIMEOUT;
+            }
+            item = pull_pop_first();
+            return Status::SUCCESS;
+        }
+
+        /// Sets the max size and the ActionIfFull of a level. (Thread-safe)
+        ///
+        /// @param level: the level, 0 is the highest priority
+        /// @param size: integer defining the max size of the level
+        /// @param action: action to undertake when the level is full
+        /// @return Status::SUCCESS or Status::ERROR if there is no such level
+        Status set_level(unsigned level, int size, ActionIfFull action) {
+            if(level >= Levels)
+                return Status::ERROR;
+            std::unique_lock<std::mutex> _lock(_mutex);
+            _levels[level]._max_size = size;
+            _levels[level]._action = action;
+            return Status::SUCCESS;
+        }
+
+        /// Gets the max size of a level. (Thread-safe)
+        ///
+        /// @param level: the level, 0 is the highest priority
+        /// @return max size of the level
+        int get_max_size(unsigned level) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _levels[level]._max_size;
+        }
+
+        /// Sets the aging period. (Thread-safe)
+        ///
+        /// @param pulls: a non-empty level is served at least once every
+        ///               that many pulls, 0 disables the aging
+        /// @return no return
+        void set_aging(unsigned pulls) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            _aging = pulls;
+        }
+
+        /// Returns the current number of items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return current number of items in the fifo
+        int size() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            size_t size = 0;
+            for(const Level& level : _levels)
+                size += level._queue.size();
+            return size;
+        }
+
+        /// Returns the current number of items of a level. (Thread-safe)
+        ///
+        /// @param level: the level, 0 is the highest priority
+        /// @return current number of items in the level
+        int size(unsigned level) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _levels[level]._queue.size();
+        }
+
+        /// Check if FIFO is empty. (Lock-free)
+        ///
+        /// @param no param
+        /// @return true or false, the value is a snapshot
+        bool is_empty() const {
+            return _bitmap.load(std::memory_order_relaxed) == 0;
+        }
+
+        /// Check if a level is full. (Thread-safe)
+        ///
+        /// @param level: the level, 0 is the highest priority
+        /// @return true or false
+        bool is_full(unsigned level) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return static_cast<int>(_levels[level]._queue.size()) >= _levels[level]._max_size;
+        }
+
+        /// Deletes all the items. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no param
+        void clear() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            for(Level& level : _levels) {
+                while(!level._queue.empty()) {
+                    T item = std::move(level._queue.front());
+                    level._queue.pop();
+                    // For C-style pointers, clear_helper() calls delete.
+                    clear_helper(item);
+                }
+            }
+            _bitmap.store(0, std::memory_order_relaxed);
+        }
+
+    protected:
+        /// Gets the first item of the level to serve then pop it
+        ///
+        /// @param no param
+        /// @return the item
+        T pull_pop_first() {
+            uint64_t bitmap = _bitmap.load(std::memory_order_relaxed);
+            unsigned level = __builtin_ctzll(bitmap);
+            if(_aging) {
+                // the lower levels not served for too long go first,
+                // the most starved one
+                uint64_t others = bitmap & (bitmap - 1);
+                uint64_t oldest = _pulls - _aging;
+                while(others) {
+                    unsigned other = __builtin_ctzll(others);
+                    if(_pulls - _levels[other]._served_at >= _aging && _levels[other]._served_at <= oldest) {
+                        level = other;
+                        oldest = _levels[other]._served_at;
+                    }
+                    others &= others - 1;
+                }
+            }
+            Level& l = _levels[level];
+            T item = std::move(l._queue.front());
+            l._queue.pop();
+            l._served_at = ++_pulls;
+            if(l._queue.empty())
+                _bitmap.fetch_and(~(uint64_t(1) << level), std::memory_order_relaxed);
+            return item;
+        }
+    };
+};
+
+#endif
@@ -0,0 +1,338 @@
+/*	=========================================================================
+	Company:
+	Filename: RecordFIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Thread-safe FIFO of variable-length byte records stored
+                    contiguously in a ring buffer. Records are written and
+                    read in place.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __RECORDFIFO_HPP__
+#define __RECORDFIFO_HPP__
+
+#include "FIFO.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+
+namespace tsFIFO {
+
+    /// Thread-safe FIFO of variable-length byte records.
+    ///
+    /// The records are stored one after the other in a ring of bytes,
+    /// each one preceded by its length. A record never wraps around the end
+    /// of the ring: if it does not fit in the remaining bytes these are
+    /// skipped with a padding record. Records are never allocated and never
+    /// copied by the FIFO: the producer writes into the span returned by
+    /// reserve() and the consumer reads from the span returned by read().
+    ///
+    /// At most one record can be reserved and one record can be read at a
+    /// time: reserve() holds the producer side until commit() and read()
+    /// holds the consumer side until release(). Both calls of a pair must be
+    /// made by the same thread.
+    ///
+    /// Example usage:
+    ///
+    ///     tsFIFO::RecordFIFO fifo(64*1024);
+    ///     tsFIFO::RecordFIFO::Span span;
+    ///     if( fifo.reserve(packet_len, span) == tsFIFO::Status::SUCCESS ) {
+    ///         recv(socket, span.data, span.size, 0);
+    ///         fifo.commit();
+    ///     }
+    ///     tsFIFO::RecordFIFO::ConstSpan record;
+    ///     fifo.read(record);
+    ///     parse(record.data, record.size);
+    ///     fifo.release();
+    ///
+    class RecordFIFO {
+
+    public:
+        /// Writable record
+        struct Span {
+            char*  data;
+            size_t size;
+        };
+
+        /// Readable record
+        struct ConstSpan {
+            const char* data;
+            size_t      size;
+            uint16_t    tag;    ///< the tag given to commit()
+        };
+
+        /// Every record starts at a multiple of this, the payload too.
+        static const size_t ALIGNMENT = alignof(std::max_align_t);
+
+    protected:
+        struct RecordHeader {
+            uint32_t _size;         ///< payload length in bytes
+            uint16_t _is_padding;   ///< skip the bytes till the end of the ring
+            uint16_t _tag;          ///< user-defined
+        };
+        static const size_t HEADER_SIZE = (sizeof(RecordHeader) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+        std::unique_ptr<char[]> _buffer;
+        size_t                  _capacity;  ///< size of the ring in bytes
+        size_t                  _head;      ///< bytes committed since the beginning
+        size_t                  _tail;      ///< bytes released since the beginning
+        int                     _count;     ///< number of records stored
+        size_t                  _reserved;  ///< offset of the current reservation
+        size_t                  _reserved_size;
+        size_t                  _read;      ///< offset of the record being read
+        std::condition_variable _condv;
+        std::condition_variable _condv_space;
+        std::mutex              _mutex;
+        std::mutex              _write_mutex;   ///< held from reserve() to commit()
+        std::mutex              _read_mutex;    ///< held from read() to release()
+
+    public:
+        /// @param size: size of the ring in bytes
+        RecordFIFO(size_t size)
+            : _capacity(align(size)), _head(0), _tail(0), _count(0),
+              _reserved(0), _reserved_size(0), _read(0) {
+            _buffer.reset(new char[_capacity]);
+        }
+        virtual ~RecordFIFO() {}
+
+        RecordFIFO(const RecordFIFO&) = delete;
+        RecordFIFO& operator=(const RecordFIFO&) = delete;
+
+    public:
+        /// Reserves a contiguous record of n bytes. (Thread-safe)
+        ///
+        /// If the FIFO does not have room for the record the function
+        /// returns immediately. On success the record must be published
+        /// with commit().
+        ///
+        /// @param n: size of the record in bytes
+        /// @param span: the writable record
+        /// @return Status::SUCCESS, Status::FULL or Status::ERROR if the
+        ///         record is bigger than the FIFO
+        Status reserve(size_t n, Span& span) {
+            return reserve(n, span, 0);
+        }
+
+        /// Reserves a contiguous record of n bytes. (Thread-safe)
+        ///
+        /// If the FIFO does not have room for the record this function
+        /// blocks until enough records are released or the timeout is reached.
+        ///
+        /// @param n: size of the record in bytes
+        /// @param span: the writable record
+        /// @param timeout: max amount of time to wait for room [ms]
+        /// @return Status::SUCCESS, Status::TIMEOUT or Status::ERROR if the
+        ///         record is bigger than the FIFO
+        Status reserve(size_t n, Span& span, unsigned timeout) {
+            if(HEADER_SIZE + align(n) > _capacity)
+                return Status::ERROR;
+            _write_mutex.lock();
+            std::unique_lock<std::mutex> _lock(_mutex);
+            size_t offset;
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+            while(!fits_helper(n, offset)) {
+                if(timeout == 0 || _condv_space.wait_until(_lock, deadline) == std::cv_status::timeout) {
+                    if(fits_helper(n, offset))
+                        break;
+                    _write_mutex.unlock();
+                    return (timeout == 0) ? Status::FULL : Status::TIMEOUT;
+                }
+            }
+            _lock.unlock();
+            // the bytes skipped at the end of the ring are marked as padding
+            size_t head = _head % _capacity;
+            if(offset != head)
+                header_at(head) = RecordHeader{0, 1, 0};
+            _reserved = offset;
+            _reserved_size = n;
+            span.data = _buffer.get() + offset + HEADER_SIZE;
+            span.size = n;
+            return Status::SUCCESS;
+        }
+
+        /// Publishes the record obtained with reserve(). (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no return
+        void commit() {
+            commit(_reserved_size);
+        }
+
+        /// Publishes the first n bytes of the record obtained with reserve(). (Thread-safe)
+        ///
+        /// Useful when the actual size is known only after writing.
+        ///
+        /// @param n: used size of the record, not bigger than the reserved one
+        /// @param tag: user-defined value handed to the consumer with the record
+        /// @return no return
+        void commit(size_t n, uint16_t tag = 0) {
+            header_at(_reserved) = RecordHeader{static_cast<uint32_t>(n), 0, tag};
+            {
+                std::unique_lock<std::mutex> _lock(_mutex);
+                size_t head = _head % _capacity;
+                if(_reserved != head)
+                    _head += _capacity - head; // padding
+                _head += HEADER_SIZE + align(n);
+                ++_count;
+            }
+            _condv.notify_one();
+            _write_mutex.unlock();
+        }
+
+        /// Drops the record obtained with reserve() without publishing it. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no return
+        void cancel() {
+            _write_mutex.unlock();
+        }
+
+        /// Gets the oldest record. (Thread-safe)
+        ///
+        /// If the fifo is empty this function blocks until new data are
+        /// available. The record must be handed back with release().
+        ///
+        /// @param record: the readable record
+        /// @return no return
+        void read(ConstSpan& record) {
+            _read_mutex.lock();
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(_count == 0) {
+                _condv.wait(_lock);
+            }
+            read_helper(record);
+        }
+
+        /// Gets the oldest record. (Thread-safe)
+        ///
+        /// If the fifo is empty this function blocks until new data are
+        /// available or the timeout is reached.
+        ///
+        /// @param record: the readable record
+        /// @param timeout: max amount of time to wait for a new record [ms]
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status read(ConstSpan& record, unsigned timeout) {
+            _read_mutex.lock();
+            std::unique_lock<std::mutex> _lock(_mutex);
+            while(_count == 0) {
+                if(_condv.wait_for(_lock, std::chrono::milliseconds(timeout))==std::cv_status::timeout) {
+                    if(_count != 0)
+                        break;
+                    _read_mutex.unlock();
+                    return Status::TIMEOUT;
+                }
+            }
+            read_helper(record);
+            return Status::SUCCESS;
+        }
+
+        /// Frees the record obtained with read(). (Thread-safe)
+        ///
+        /// @param no param
+        /// @return no return
+        void release() {
+            {
+                std::unique_lock<std::mutex> _lock(_mutex);
+                _tail += HEADER_SIZE + align(header_at(_read)._size);
+                --_count;
+            }
+            _condv_space.notify_all();
+            _read_mutex.unlock();
+        }
+
+        /// Returns the current number of records. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return current number of records in the fifo
+        int size() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _count;
+        }
+
+        /// Returns the number of bytes in use, headers and padding included. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return bytes in use
+        size_t size_bytes() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _head - _tail;
+        }
+
+        /// Gets the size of the ring.
+        ///
+        /// @param no param
+        /// @return size of the ring in bytes
+        size_t get_max_size() {
+            return _capacity;
+        }
+
+        /// Deletes all the records. (Thread-safe)
+        ///
+        /// Must not be called while a record is being read.
+        ///
+        /// @param no param
+        /// @return no param
+        void clear() {
+            {
+                std::unique_lock<std::mutex> _lock(_mutex);
+                _tail = _head;
+                _count = 0;
+            }
+            _condv_space.notify_all();
+        }
+
+    protected:
+        static size_t align(size_t n) {
+            return (n + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        }
+
+        RecordHeader& header_at(size_t offset) {
+            return *reinterpret_cast<RecordHeader*>(_buffer.get() + offset);
+        }
+
+        /// Checks if a record of n bytes fits in the free space, the mutex
+        /// and the write mutex must be locked.
+        ///
+        /// An empty ring starts again from the beginning: otherwise a
+        /// record wrapping around would not fit behind the old offset.
+        ///
+        /// @param n: size of the record in bytes
+        /// @param offset: where the record goes
+        /// @return true or false
+        bool fits_helper(size_t n, size_t& offset) {
+            if(_head == _tail)
+                _head = _tail = 0;
+            size_t head = _head % _capacity;
+            size_t needed = HEADER_SIZE + align(n);
+            size_t free = _capacity - (_head - _tail);
+            if(head + needed <= _capacity) {
+                offset = head;
+                return needed <= free;
+            }
+            // wrap around: the end of the ring becomes padding
+            offset = 0;
+            return (_capacity - head) + needed <= free;
+        }
+
+        /// Skips the padding and returns the oldest record.
+        void read_helper(ConstSpan& record) {
+            size_t tail = _tail % _capacity;
+            if(header_at(tail)._is_padding) {
+                _tail += _capacity - tail;
+                tail = 0;
+            }
+            _read = tail;
+            record.data = _buffer.get() + tail + HEADER_SIZE;
+            record.size = header_at(tail)._size;
+            record.tag = header_at(tail)._tag;
+        }
+    };
+};
+
+#endif
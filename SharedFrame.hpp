@@ -0,0 +1,210 @@
+/*	=========================================================================
+	Company:
+	Filename: SharedFrame.hpp
+	Last modifed:   17.10.2026
+	Description:    Reference-counted handle to share an item between several
+                    FIFOs without copying it. The reference counts live in
+                    pooled, cache-line-padded blocks away from the items.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __SHAREDFRAME_HPP__
+#define __SHAREDFRAME_HPP__
+
+#include "FIFO.hpp"
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <utility>
+
+namespace tsFIFO {
+
+    template<typename T> class SharedPool;
+
+    namespace shared_detail {
+
+        /// Reference count of a shared item, one per cache line so that
+        /// updating it does not invalidate the item nor the other counts.
+        template<typename T>
+        struct alignas(64) ControlBlock : CacheAligned {
+            std::atomic<int> _refs;
+            T*               _item;
+            SharedPool<T>*   _pool;
+            ControlBlock*    _next; ///< free list of the pool
+        };
+    }
+
+    /// Handle to an item shared between several FIFOs.
+    ///
+    /// Copying a handle increments the reference count, the item is deleted
+    /// when the last handle goes away. Unlike std::shared_ptr the reference
+    /// count is not allocated next to the item: the consumers releasing
+    /// their handles do not bounce the cache lines of the item.
+    ///
+    /// Handles are obtained from a SharedPool, which must outlive them.
+    template<typename T> class SharedFrame {
+
+        friend class SharedPool<T>;
+        template<typename U, typename... FIFOs>
+        friend Status push_shared(SharedFrame<U>& frame, FIFOs&... fifos);
+
+        using Block = shared_detail::ControlBlock<T>;
+
+    private:
+        Block* _block;
+
+        /// Takes over a reference already counted.
+        explicit SharedFrame(Block* block) : _block(block) {}
+
+    public:
+        SharedFrame() : _block(nullptr) {}
+        SharedFrame(const SharedFrame& other) : _block(other._block) {
+            if(_block)
+                _block->_refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        // noexcept: std::vector and std::deque move the handles instead
+        // of copying them, which would touch the reference counts
+        SharedFrame(SharedFrame&& other) noexcept : _block(other._block) {
+            other._block = nullptr;
+        }
+        SharedFrame& operator=(SharedFrame other) noexcept {
+            std::swap(_block, other._block);
+            return *this;
+        }
+        ~SharedFrame() {
+            reset();
+        }
+
+        /// Drops this reference. The item is deleted if it was the last one.
+        ///
+        /// @param no param
+        /// @return no return
+        void reset() {
+            if(_block && _block->_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                _block->_pool->destroy(_block);
+            _block = nullptr;
+        }
+
+        T* get() const { return _block ? _block->_item : nullptr; }
+        T* operator->() const { return _block->_item; }
+        T& operator*() const { return *_block->_item; }
+        explicit operator bool() const { return _block != nullptr; }
+
+        /// Returns the number of handles to the item. The value is a snapshot.
+        ///
+        /// @param no param
+        /// @return number of handles
+        int use_count() const {
+            return _block ? _block->_refs.load(std::memory_order_relaxed) : 0;
+        }
+    };
+
+    /// Pool of reference counts for SharedFrame. (Thread-safe)
+    ///
+    /// The blocks are allocated in chunks and recycled through a free list,
+    /// making a new shared item costs one allocation for the item only.
+    ///
+    /// Example usage:
+    ///
+    ///     tsFIFO::SharedPool<Frame> pool;
+    ///     tsFIFO::FIFO<tsFIFO::SharedFrame<Frame>> recorder(10), streamer(10), analytics(10);
+    ///     tsFIFO::SharedFrame<Frame> frame = pool.make(width, height);
+    ///     tsFIFO::push_shared(frame, recorder, streamer, analytics);
+    ///
+    template<typename T> class SharedPool {
+
+        friend class SharedFrame<T>;
+        using Block = shared_detail::ControlBlock<T>;
+
+    private:
+        std::vector<std::unique_ptr<Block[]>> _chunks;
+        Block*      _free;
+        size_t      _chunk_size;
+        std::mutex  _mutex;
+
+    public:
+        /// @param chunk_size: number of blocks allocated at once
+        SharedPool(size_t chunk_size = 64) : _free(nullptr), _chunk_size(chunk_size) {}
+
+        SharedPool(const SharedPool&) = delete;
+        SharedPool& operator=(const SharedPool&) = delete;
+
+        /// Creates a shared item. (Thread-safe)
+        ///
+        /// @param args: arguments forwarded to the constructor of T
+        /// @return the first handle to the item
+        template<typename... Args>
+        SharedFrame<T> make(Args&&... args) {
+            return adopt(std::unique_ptr<T>(new T(std::forward<Args>(args)...)));
+        }
+
+        /// Shares an existing item. (Thread-safe)
+        ///
+        /// @param item: the item, now owned by the handles
+        /// @return the first handle to the item
+        SharedFrame<T> adopt(std::unique_ptr<T> item) {
+            Block* block;
+            {
+                std::unique_lock<std::mutex> _lock(_mutex);
+                if(!_free)
+                    grow_helper();
+                block = _free;
+                _free = block->_next;
+            }
+            block->_refs.store(1, std::memory_order_relaxed);
+            block->_item = item.release();
+            block->_pool = this;
+            return SharedFrame<T>(block);
+        }
+
+    private:
+        void grow_helper() {
+            _chunks.emplace_back(new Block[_chunk_size]);
+            Block* chunk = _chunks.back().get();
+            for(size_t i=0; i<_chunk_size; ++i) {
+                chunk[i]._next = _free;
+                _free = &chunk[i];
+            }
+        }
+
+        void destroy(Block* block) {
+            delete block->_item;
+            block->_item = nullptr;
+            std::unique_lock<std::mutex> _lock(_mutex);
+            block->_next = _free;
+            _free = block;
+        }
+    };
+
+    // Pushes a handle holding a reference; if the FIFO does not take it,
+    // the reference is dropped with the handle.
+    template<typename T, typename F>
+    Status push_shared_helper(SharedFrame<T>&& frame, F& fifo) {
+        return fifo.push(frame);
+    }
+
+    /// Pushes the same item into several FIFOs. (Thread-safe)
+    ///
+    /// The reference count is incremented once for all the FIFOs, the
+    /// item is not copied. The references not taken by a full FIFO are
+    /// given back.
+    ///
+    /// @param frame: the item to share, not empty
+    /// @param fifos: FIFOs of SharedFrame<T>
+    /// @return Status::SUCCESS or Status::FULL if any of the FIFOs was full
+    template<typename T, typename... FIFOs>
+    Status push_shared(SharedFrame<T>& frame, FIFOs&... fifos) {
+        frame._block->_refs.fetch_add(sizeof...(FIFOs), std::memory_order_relaxed);
+        Status statuses[] = { push_shared_helper(SharedFrame<T>(frame._block), fifos)... };
+        for(Status status : statuses)
+            if(status != Status::SUCCESS)
+                return status;
+        return Status::SUCCESS;
+    }
+};
+
+#endif
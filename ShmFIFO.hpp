@@ -0,0 +1,668 @@
+/*	=========================================================================
+	Company:
+	Filename: ShmFIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Inter-process FIFO living in a shared-memory region
+                    (shm_open or memfd). Items are written and read in place
+                    through claim()/commit() and peek()/release(), waiting
+                    is done on process-shared futexes.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __SHMFIFO_HPP__
+#define __SHMFIFO_HPP__
+
+#include "FIFO.hpp"
+#include <unistd.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <ctime>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+
+namespace tsFIFO {
+
+    enum class ShmMode : uint32_t {
+        SPSC = 1, ///< one producer process/thread and one consumer process/thread
+        MPMC = 2 ///< any number of producers and consumers
+    };
+
+    namespace shm_detail {
+
+        const uint32_t MAGIC = 0x46494630; // "FIF0"
+
+        // While blocked, waiters wake up at least this often to check whether
+        // the peer holding the slot they are waiting for is still alive.
+        const unsigned RECOVERY_PERIODms = 10;
+
+        // A slot is claimed/peeked before its owner stores its pid. A slot
+        // seen without a pid for this long is taken back: its owner died in
+        // between. An owner that was only slow takes another slot.
+        const unsigned STALE_SLOTms = 100;
+
+        // A process waiting for the creator of the region to initialize it
+        // checks every this often whether the creator is still alive.
+        const unsigned ATTACH_TIMEOUTms = 1000;
+
+        // pid of the owner of a slot taken back from a dead process. The
+        // consumers skip a slot revoked from its producer.
+        const uint32_t REVOKED = 0xffffffff;
+
+        // The futex words are 32 bits wide and live in the shared region, so
+        // they must be address-free.
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+        static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+                      "atomics in shared memory must be lock-free");
+
+        inline void futex_wait(std::atomic<uint32_t>* word, uint32_t expected, unsigned timeout) {
+            struct timespec ts;
+            ts.tv_sec = timeout / 1000;
+            ts.tv_nsec = (timeout % 1000) * 1000000L;
+            // FUTEX_WAIT (not the _PRIVATE variant) so that waiters and
+            // wakers can be in different processes.
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+        }
+
+        inline void futex_wake(std::atomic<uint32_t>* word, int n) {
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, n, nullptr, nullptr, 0);
+        }
+
+        // pid of the calling process. It is cached as getpid() is a system
+        // call, the cache is refreshed in the children after fork().
+        inline int32_t self_pid() {
+            static int32_t pid = [](){
+                pthread_atfork(nullptr, nullptr, [](){ pid = static_cast<int32_t>(getpid()); });
+                return static_cast<int32_t>(getpid());
+            }();
+            return pid;
+        }
+
+        inline bool is_alive(int32_t pid) {
+            return (kill(pid, 0) == 0) || (errno == EPERM);
+        }
+
+        // The owner word of a slot: the position in the high half, so that a
+        // compare-and-swap cannot take the slot of another lap, and the pid
+        // of the owner in the low half.
+        inline uint64_t owner_word(uint64_t pos, uint32_t pid) {
+            return (pos << 32) | pid;
+        }
+
+        inline uint32_t owner_pid(uint64_t word) {
+            return static_cast<uint32_t>(word);
+        }
+
+        inline int64_t now_ms() {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        /// Process-local watch of the last slot seen taken without a pid.
+        class UnownedWatch {
+            std::atomic<uint64_t> _pos;
+            std::atomic<int64_t>  _since; ///< [ms]
+
+        public:
+            UnownedWatch() : _pos(UINT64_MAX), _since(0) {}
+
+            /// @param pos: position of the slot seen without a pid
+            /// @return true if it has been seen so for STALE_SLOTms
+            bool stale(uint64_t pos) {
+                int64_t now = now_ms();
+                if(_pos.exchange(pos) != pos) {
+                    _since.store(now);
+                    return false;
+                }
+                return now - _since.load() >= STALE_SLOTms;
+            }
+        };
+
+        /// Control block at the beginning of the shared region.
+        ///
+        /// Nothing in here is a pointer: the slots are found through
+        /// _slots_offset so that every process can map the region at a
+        /// different address.
+        struct Header {
+            std::atomic<uint32_t> _state;   ///< 0: zero-filled, 1: being initialized, 2: ready
+            std::atomic<int32_t>  _creator; ///< pid of the process initializing the region
+            uint32_t _magic;
+            uint32_t _mode;
+            uint32_t _capacity;             ///< number of slots, power of two
+            uint32_t _slot_size;
+            uint64_t _slots_offset;         ///< offset of the first slot from the header
+            alignas(64) std::atomic<uint64_t> _head; ///< next position to claim
+            alignas(64) std::atomic<uint64_t> _tail; ///< next position to peek
+            alignas(64) std::atomic<uint32_t> _data_futex;
+            std::atomic<uint32_t> _data_waiters;
+            alignas(64) std::atomic<uint32_t> _space_futex;
+            std::atomic<uint32_t> _space_waiters;
+        };
+
+        /// A slot of the ring.
+        ///
+        /// The sequence number tells in which state the slot is for the
+        /// position pos that maps onto it:
+        ///     _seq == pos             free, or claimed by a producer (head > pos)
+        ///     _seq == pos+1           committed, or peeked by a consumer (tail > pos)
+        ///     _seq == pos+capacity    released, free for the next lap
+        /// _owner is the owner_word() of pos and of the pid of the process
+        /// that claimed/peeked the slot: 0 if none, REVOKED if the slot was
+        /// taken back from a dead producer before commit().
+        template<typename T>
+        struct alignas(64) Slot {
+            std::atomic<uint64_t> _seq;
+            std::atomic<uint64_t> _owner;
+            T                     _payload;
+        };
+    }
+
+    /// Inter-process FIFO placed in a shared-memory region.
+    ///
+    /// The region contains a fixed-size ring of slots. Producers claim() a
+    /// slot, construct the payload directly in the shared memory and commit()
+    /// it, consumers peek() at the oldest committed slot and release() it
+    /// once processed: a transfer between two processes copies nothing.
+    ///
+    /// The region can be named (shm_open) or anonymous (memfd inherited by
+    /// fork() or passed over a unix socket). Blocked producers and consumers
+    /// sleep on process-shared futexes. If a process dies while holding a
+    /// claimed or peeked slot, the slot is recovered by its peers: abandoned
+    /// claims are skipped by the consumers and abandoned peeks are released
+    /// by the producers. A process dying right after taking a slot, before
+    /// storing its pid in it, is detected after STALE_SLOTms. A process
+    /// attaching while the creator of the region is dead before the end of
+    /// the initialization takes it over.
+    ///
+    /// T must be trivially copyable as it is shared between processes.
+    ///
+    /// Example usage:
+    ///
+    ///     struct Frame { uint64_t idx; uint8_t pixels[640*480]; };
+    ///     // producer process
+    ///     tsFIFO::ShmFIFO<Frame> fifo("/frames", 8);
+    ///     Frame* frame = fifo.claim(TIMEOUTms);
+    ///     if( frame ) {
+    ///         capture_into(frame->pixels);
+    ///         fifo.commit(frame);
+    ///     }
+    ///     // consumer process
+    ///     tsFIFO::ShmFIFO<Frame> fifo("/frames", 8);
+    ///     const Frame* frame = fifo.peek();
+    ///     encode(frame->pixels);
+    ///     fifo.release(frame);
+    ///
+    template<typename T, ShmMode mode = ShmMode::MPMC> class ShmFIFO {
+
+        static_assert(std::is_trivially_copyable<T>::value, "ShmFIFO items must be trivially copyable");
+
+        using Header = shm_detail::Header;
+        using Slot = shm_detail::Slot<T>;
+
+    private:
+        Header*  _header;
+        Slot*    _slots;
+        size_t   _region_size;
+        uint64_t _mask;
+        shm_detail::UnownedWatch _unowned_claim;
+        shm_detail::UnownedWatch _unowned_peek;
+
+    public:
+        /// Creates or attaches to the named region /name.
+        ///
+        /// @param name: name of the shared-memory object, as for shm_open()
+        /// @param size: number of slots, rounded up to a power of two
+        ShmFIFO(const std::string& name, int size) {
+            int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+            if(fd < 0)
+                throw std::runtime_error("ShmFIFO: shm_open() failed: " + std::string(strerror(errno)));
+            try {
+                attach(fd, size);
+            } catch(...) {
+                close(fd);
+                throw;
+            }
+            close(fd);
+        }
+
+        /// Attaches to the region behind a file descriptor (e.g. memfd).
+        ///
+        /// The descriptor is not owned and can be closed afterward.
+        ///
+        /// @param fd: file descriptor of the region
+        /// @param size: number of slots, rounded up to a power of two
+        ShmFIFO(int fd, int size) {
+            attach(fd, size);
+        }
+
+        ShmFIFO(const ShmFIFO&) = delete;
+        ShmFIFO& operator=(const ShmFIFO&) = delete;
+
+        ~ShmFIFO() {
+            munmap(_header, _region_size);
+        }
+
+        /// Creates an anonymous region to be shared with child processes.
+        ///
+        /// @param name: name shown in /proc/<pid>/fd, for debugging purposes
+        /// @return the file descriptor
+        static int create_memfd(const std::string& name) {
+            int fd = memfd_create(name.c_str(), 0);
+            if(fd < 0)
+                throw std::runtime_error("ShmFIFO: memfd_create() failed: " + std::string(strerror(errno)));
+            return fd;
+        }
+
+        /// Removes the named region. Processes still attached keep using it.
+        ///
+        /// @param name: name of the shared-memory object
+        /// @return no return
+        static void unlink(const std::string& name) {
+            shm_unlink(name.c_str());
+        }
+
+    public:
+        /// Claims a free slot for writing. (Process-safe)
+        ///
+        /// The returned slot must be filled in place and then handed to
+        /// commit(). Returns immediately if the FIFO is full.
+        ///
+        /// @param no param
+        /// @return the slot or nullptr if the FIFO is full
+        T* claim() {
+            return try_claim();
+        }
+
+        /// Claims a free slot for writing. (Process-safe)
+        ///
+        /// If the FIFO is full this function blocks until a slot is released
+        /// or the timeout is reached.
+        ///
+        /// @param timeout: max amount of time to wait for a free slot [ms]
+        /// @return the slot or nullptr on timeout
+        T* claim(unsigned timeout) {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+            for(;;) {
+                T* payload = try_claim();
+                if(payload)
+                    return payload;
+                if(!wait(_header->_space_futex, _header->_space_waiters, deadline, [this](){ return has_space(); })) {
+                    // waited for a whole period: maybe the consumer holding the slot died
+                    if(!recover_consumer() && std::chrono::steady_clock::now() >= deadline)
+                        return try_claim();
+                }
+            }
+        }
+
+        /// Publishes a slot obtained with claim(). (Process-safe)
+        ///
+        /// @param payload: the slot returned by claim()
+        /// @return no return
+        void commit(T* payload) {
+            Slot& slot = slot_of(payload);
+            uint64_t pos = slot._seq.load(std::memory_order_relaxed);
+            slot._owner.store(shm_detail::owner_word(pos, 0), std::memory_order_relaxed);
+            slot._seq.store(pos + 1, std::memory_order_release);
+            notify(_header->_data_futex, _header->_data_waiters);
+        }
+
+        /// Gets the oldest committed slot for reading. (Process-safe)
+        ///
+        /// If the fifo is empty this function blocks until new data are
+        /// available. The slot must be handed back with release().
+        ///
+        /// @param no param
+        /// @return the slot
+        const T* peek() {
+            const T* payload;
+            while(!(payload = peek(shm_detail::RECOVERY_PERIODms)))
+                ;
+            return payload;
+        }
+
+        /// Gets the oldest committed slot for reading. (Process-safe)
+        ///
+        /// If the fifo is empty this function blocks until new data are
+        /// available or the timeout is reached.
+        ///
+        /// @param timeout: max amount of time to wait for a new item [ms]
+        /// @return the slot or nullptr on timeout
+        const T* peek(unsigned timeout) {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+            for(;;) {
+                const T* payload = try_peek();
+                if(payload)
+                    return payload;
+                if(!wait(_header->_data_futex, _header->_data_waiters, deadline, [this](){ return has_data(); })) {
+                    // waited for a whole period: maybe the producer holding the slot died
+                    if(!recover_producer() && std::chrono::steady_clock::now() >= deadline)
+                        return try_peek();
+                }
+            }
+        }
+
+        /// Frees a slot obtained with peek(). (Process-safe)
+        ///
+        /// @param payload: the slot returned by peek()
+        /// @return no return
+        void release(const T* payload) {
+            release_slot(slot_of(payload));
+        }
+
+        /// Copies an item into the FIFO. (Process-safe)
+        ///
+        /// @param item: element to push into the fifo
+        /// @return either Status::FULL or Status::SUCCESS
+        Status push(const T& item) {
+            T* payload = try_claim();
+            if(!payload)
+                return Status::FULL;
+            *payload = item;
+            commit(payload);
+            return Status::SUCCESS;
+        }
+
+        /// Copies the oldest item out of the FIFO. (Process-safe)
+        ///
+        /// If the fifo is empty this function blocks until new data are available.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @return no return
+        void pull(T& item) {
+            const T* payload = peek();
+            item = *payload;
+            release(payload);
+        }
+
+        /// Copies the oldest item out of the FIFO. (Process-safe)
+        ///
+        /// @param item: element pulled from the fifo
+        /// @param timeout: max amount of time to wait for a new item [ms]
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status pull(T& item, unsigned timeout) {
+            const T* payload = peek(timeout);
+            if(!payload)
+                return Status::TIMEOUT;
+            item = *payload;
+            release(payload);
+            return Status::SUCCESS;
+        }
+
+        /// Returns the current number of items, including the claimed and
+        /// peeked ones. The value is a snapshot.
+        ///
+        /// @param no param
+        /// @return current number of items in the fifo
+        int size() {
+            uint64_t tail = _header->_tail.load(std::memory_order_acquire);
+            uint64_t head = _header->_head.load(std::memory_order_acquire);
+            return (head > tail) ? static_cast<int>(head - tail) : 0;
+        }
+
+        /// Gets the max FIFO size.
+        ///
+        /// @param no param
+        /// @return number of slots
+        int get_max_size() {
+            return static_cast<int>(_header->_capacity);
+        }
+
+        /// Check if FIFO is full. The value is a snapshot.
+        ///
+        /// @param no param
+        /// @return true or false
+        bool is_full() {
+            return !has_space();
+        }
+
+    private:
+        void attach(int fd, int size) {
+            uint32_t capacity = 1;
+            while(capacity < static_cast<uint32_t>(size))
+                capacity <<= 1;
+            uint64_t slots_offset = (sizeof(Header) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+            _region_size = slots_offset + capacity * sizeof(Slot);
+
+            struct stat st;
+            if(fstat(fd, &st) < 0)
+                throw std::runtime_error("ShmFIFO: fstat() failed: " + std::string(strerror(errno)));
+            // a fresh object is zero-filled after ftruncate(), hence _state == 0
+            if(static_cast<size_t>(st.st_size) < _region_size && ftruncate(fd, _region_size) < 0)
+                throw std::runtime_error("ShmFIFO: ftruncate() failed: " + std::string(strerror(errno)));
+
+            void* base = mmap(nullptr, _region_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if(base == MAP_FAILED)
+                throw std::runtime_error("ShmFIFO: mmap() failed: " + std::string(strerror(errno)));
+            _header = static_cast<Header*>(base);
+            _slots = reinterpret_cast<Slot*>(static_cast<char*>(base) + slots_offset);
+            _mask = capacity - 1;
+
+            // the first process to get here initializes the region, the others
+            // wait. If the creator died meanwhile, a waiter takes over.
+            uint32_t state = 0;
+            if(_header->_state.compare_exchange_strong(state, 1)) {
+                int32_t none = 0;
+                if(_header->_creator.compare_exchange_strong(none, shm_detail::self_pid()))
+                    initialize(capacity, slots_offset);
+            }
+            int64_t since = shm_detail::now_ms();
+            while(_header->_state.load(std::memory_order_acquire) != 2) {
+                usleep(100);
+                if(shm_detail::now_ms() - since < shm_detail::ATTACH_TIMEOUTms)
+                    continue;
+                // 0: the creator died between setting _state and _creator
+                int32_t creator = _header->_creator.load();
+                if((creator == 0 || !shm_detail::is_alive(creator))
+                        && _header->_creator.compare_exchange_strong(creator, shm_detail::self_pid()))
+                    initialize(capacity, slots_offset);
+                since = shm_detail::now_ms();
+            }
+
+            if(_header->_magic != shm_detail::MAGIC
+                    || _header->_mode != static_cast<uint32_t>(mode)
+                    || _header->_capacity != capacity
+                    || _header->_slot_size != sizeof(Slot)
+                    || _header->_slots_offset != slots_offset) {
+                munmap(base, _region_size);
+                throw std::runtime_error("ShmFIFO: the region was created with a different layout");
+            }
+        }
+
+        void initialize(uint32_t capacity, uint64_t slots_offset) {
+            _header->_magic = shm_detail::MAGIC;
+            _header->_mode = static_cast<uint32_t>(mode);
+            _header->_capacity = capacity;
+            _header->_slot_size = sizeof(Slot);
+            _header->_slots_offset = slots_offset;
+            _header->_head.store(0, std::memory_order_relaxed);
+            _header->_tail.store(0, std::memory_order_relaxed);
+            _header->_data_futex.store(0, std::memory_order_relaxed);
+            _header->_data_waiters.store(0, std::memory_order_relaxed);
+            _header->_space_futex.store(0, std::memory_order_relaxed);
+            _header->_space_waiters.store(0, std::memory_order_relaxed);
+            for(uint64_t i=0; i<capacity; ++i) {
+                _slots[i]._seq.store(i, std::memory_order_relaxed);
+                _slots[i]._owner.store(shm_detail::owner_word(i, 0), std::memory_order_relaxed);
+            }
+            _header->_state.store(2, std::memory_order_release);
+        }
+
+        Slot& slot_at(uint64_t pos) {
+            return _slots[pos & _mask];
+        }
+
+        Slot& slot_of(const T* payload) {
+            return *reinterpret_cast<Slot*>(reinterpret_cast<char*>(const_cast<T*>(payload)) - offsetof(Slot, _payload));
+        }
+
+        bool has_space() {
+            uint64_t pos = _header->_head.load(std::memory_order_relaxed);
+            return slot_at(pos)._seq.load(std::memory_order_acquire) == pos;
+        }
+
+        bool has_data() {
+            uint64_t pos = _header->_tail.load(std::memory_order_relaxed);
+            return slot_at(pos)._seq.load(std::memory_order_acquire) == pos + 1;
+        }
+
+        /// Advances head or tail from pos to pos+1.
+        /// A single producer/consumer does not need the compare-and-swap.
+        bool advance(std::atomic<uint64_t>& index, uint64_t& pos) {
+            if(mode == ShmMode::SPSC) {
+                index.store(pos + 1, std::memory_order_relaxed);
+                return true;
+            }
+            return index.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed);
+        }
+
+        T* try_claim() {
+            uint64_t pos = _header->_head.load(std::memory_order_relaxed);
+            for(;;) {
+                Slot& slot = slot_at(pos);
+                int64_t diff = static_cast<int64_t>(slot._seq.load(std::memory_order_acquire) - pos);
+                if(diff == 0) {
+                    if(advance(_header->_head, pos)) {
+                        // the pid is stored once the claim is published: a
+                        // recovery may have revoked it in between
+                        uint64_t unowned = shm_detail::owner_word(pos, 0);
+                        if(slot._owner.compare_exchange_strong(unowned, shm_detail::owner_word(pos, shm_detail::self_pid())))
+                            return &slot._payload;
+                        pos = _header->_head.load(std::memory_order_relaxed);
+                    }
+                } else if(diff < 0) {
+                    return nullptr; // full
+                } else {
+                    pos = _header->_head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        const T* try_peek() {
+            uint64_t pos = _header->_tail.load(std::memory_order_relaxed);
+            for(;;) {
+                Slot& slot = slot_at(pos);
+                int64_t diff = static_cast<int64_t>(slot._seq.load(std::memory_order_acquire) - (pos + 1));
+                if(diff == 0) {
+                    if(advance(_header->_tail, pos)) {
+                        uint64_t self = shm_detail::owner_word(pos, shm_detail::self_pid());
+                        uint64_t committed = shm_detail::owner_word(pos, 0);
+                        uint64_t abandoned = shm_detail::owner_word(pos, shm_detail::REVOKED);
+                        if(slot._owner.compare_exchange_strong(committed, self))
+                            return &slot._payload;
+                        // the producer died before commit(): skip the slot.
+                        // Otherwise a recovery revoked the peek in between.
+                        if(slot._owner.compare_exchange_strong(abandoned, self))
+                            release_slot(slot);
+                        pos = _header->_tail.load(std::memory_order_relaxed);
+                    }
+                } else if(diff < 0) {
+                    return nullptr; // empty
+                } else {
+                    pos = _header->_tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void release_slot(Slot& slot) {
+            uint64_t pos = slot._seq.load(std::memory_order_relaxed) - 1;
+            slot._owner.store(shm_detail::owner_word(pos + _mask + 1, 0), std::memory_order_relaxed);
+            slot._seq.store(pos + _mask + 1, std::memory_order_release);
+            notify(_header->_space_futex, _header->_space_waiters);
+        }
+
+        /// Unblocks the consumers if the producer of the oldest slot died
+        /// between claim() and commit().
+        ///
+        /// @return true if a slot has been recovered
+        bool recover_producer() {
+            uint64_t pos = _header->_tail.load(std::memory_order_acquire);
+            Slot& slot = slot_at(pos);
+            if(slot._seq.load(std::memory_order_acquire) != pos
+                    || _header->_head.load(std::memory_order_acquire) <= pos)
+                return false; // not claimed
+            uint64_t word = slot._owner.load();
+            uint32_t owner = shm_detail::owner_pid(word);
+            if(word != shm_detail::owner_word(pos, owner) || owner == shm_detail::REVOKED)
+                return false; // of another lap, or being revoked by somebody else
+            // owner == 0: the producer has not stored its pid yet, or died before
+            if(owner == 0 ? !_unowned_claim.stale(pos) : shm_detail::is_alive(static_cast<int32_t>(owner)))
+                return false;
+            if(!slot._owner.compare_exchange_strong(word, shm_detail::owner_word(pos, shm_detail::REVOKED)))
+                return false;
+            slot._seq.store(pos + 1, std::memory_order_release);
+            notify(_header->_data_futex, _header->_data_waiters);
+            return true;
+        }
+
+        /// Unblocks the producers if the consumer of the slot they need died
+        /// between peek() and release().
+        ///
+        /// @return true if a slot has been recovered
+        bool recover_consumer() {
+            uint64_t head = _header->_head.load(std::memory_order_acquire);
+            uint64_t pos = head - (_mask + 1); // position of the previous lap
+            Slot& slot = slot_at(head);
+            if(head <= _mask
+                    || slot._seq.load(std::memory_order_acquire) != pos + 1
+                    || _header->_tail.load(std::memory_order_acquire) <= pos)
+                return false; // not peeked
+            uint64_t word = slot._owner.load();
+            uint32_t owner = shm_detail::owner_pid(word);
+            if(word != shm_detail::owner_word(pos, owner))
+                return false;
+            // 0 or REVOKED: the consumer has not stored its pid yet, or died before
+            bool unowned = (owner == 0 || owner == shm_detail::REVOKED);
+            if(unowned ? !_unowned_peek.stale(pos) : shm_detail::is_alive(static_cast<int32_t>(owner)))
+                return false;
+            if(!slot._owner.compare_exchange_strong(word, shm_detail::owner_word(pos, shm_detail::self_pid())))
+                return false;
+            release_slot(slot);
+            return true;
+        }
+
+        /// Sleeps on a futex until pred() holds, the deadline or a recovery period expires.
+        ///
+        /// @return true if pred() may hold, false if a whole recovery period elapsed
+        template<typename Pred>
+        bool wait(std::atomic<uint32_t>& futex, std::atomic<uint32_t>& waiters,
+                  std::chrono::steady_clock::time_point deadline, Pred pred) {
+            auto now = std::chrono::steady_clock::now();
+            if(now >= deadline)
+                return false;
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count() + 1;
+            unsigned period = (left < shm_detail::RECOVERY_PERIODms) ? static_cast<unsigned>(left)
+                                                                     : shm_detail::RECOVERY_PERIODms;
+            // The waiter is registered before sampling the futex word and the
+            // word is sampled before checking the condition: a notify() that
+            // follows either sees the waiter or changes the word.
+            waiters.fetch_add(1);
+            uint32_t word = futex.load();
+            bool ready = pred();
+            if(!ready)
+                shm_detail::futex_wait(&futex, word, period);
+            waiters.fetch_sub(1);
+            return ready || futex.load() != word;
+        }
+
+        void notify(std::atomic<uint32_t>& futex, std::atomic<uint32_t>& waiters) {
+            futex.fetch_add(1);
+            if(waiters.load() > 0)
+                shm_detail::futex_wake(&futex, 1);
+        }
+    };
+};
+
+#endif
@@ -0,0 +1,232 @@
+/*	=========================================================================
+	Company:
+	Filename: SynchronousFIFO.hpp
+	Last modifed:   17.10.2026
+	Description:    Thread-safe rendezvous channel without storage: an item
+                    is handed directly from a producer to a waiting consumer.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __SYNCHRONOUSFIFO_HPP__
+#define __SYNCHRONOUSFIFO_HPP__
+
+#include "FIFO.hpp"
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <utility>
+
+namespace tsFIFO {
+
+    /// Thread-safe synchronous FIFO, of capacity zero.
+    ///
+    /// There is no queue of items, only a queue of the threads waiting: the
+    /// consumers waiting for an item or the producers waiting for a
+    /// consumer, never both at once. A waiting thread lends its own item
+    /// to the queue and sleeps on its own condition variable. push() moves
+    /// the item straight into the variable of the oldest waiting consumer
+    /// and wakes that consumer only. If no consumer is waiting push()
+    /// returns FULL at once, or waits for one until the timeout.
+    ///
+    /// Example usage:
+    ///
+    ///     tsFIFO::SynchronousFIFO<std::unique_ptr<Connection>> fifo;
+    ///
+    ///     // acceptor thread
+    ///     if( fifo.push(connection) == tsFIFO::Status::FULL )
+    ///         reject(connection); // all the workers are busy
+    ///
+    ///     // worker thread
+    ///     fifo.pull(connection);
+    ///
+    template<typename T> class SynchronousFIFO {
+
+    protected:
+        /// A waiting thread, on its own stack.
+        struct Waiter {
+            T*                      _item;  ///< the item to fill (consumer) or to take (producer)
+            bool                    _done;  ///< the handoff took place
+            Waiter*                 _next;
+            std::condition_variable _condv;
+        };
+
+        Waiter*     _head;          ///< waiting threads, the oldest first
+        Waiter*     _tail;
+        bool        _consumers;     ///< the waiting threads are consumers
+        int         _waiting;
+        std::mutex  _mutex;
+
+    public:
+        SynchronousFIFO() : _head(nullptr), _tail(nullptr), _consumers(true), _waiting(0) {}
+        virtual ~SynchronousFIFO() {}
+
+        SynchronousFIFO(const SynchronousFIFO&) = delete;
+        SynchronousFIFO& operator=(const SynchronousFIFO&) = delete;
+
+    public:
+        /// Hands an item to a waiting consumer. (Thread-safe)
+        ///
+        /// @param item: element to hand over, left untouched on failure
+        /// @return Status::SUCCESS or Status::FULL if no consumer is waiting
+        Status push(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            if(!_head || !_consumers)
+                return Status::FULL;
+            handoff_helper(item, true);
+            return Status::SUCCESS;
+        }
+
+        /// Hands an item to a consumer. (Thread-safe)
+        ///
+        /// If no consumer is waiting this function blocks until one comes
+        /// or the timeout is reached.
+        ///
+        /// @param item: element to hand over, left untouched on failure
+        /// @param timeout: max amount of time to wait for a consumer [ms]
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status push(T& item, unsigned timeout) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            if(_head && _consumers) {
+                handoff_helper(item, true);
+                return Status::SUCCESS;
+            }
+            return wait_helper(item, false, _lock, timeout);
+        }
+
+        /// Retrieves an item from a producer. (Thread-safe)
+        ///
+        /// This function blocks until a producer hands an item.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @return no return
+        void pull(T& item) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            if(_head && !_consumers) {
+                handoff_helper(item, false);
+                return;
+            }
+            Waiter waiter{&item, false, nullptr};
+            enqueue_helper(waiter, true);
+            while(!waiter._done)
+                waiter._condv.wait(_lock);
+        }
+
+        /// Retrieves an item from a producer. (Thread-safe)
+        ///
+        /// This function blocks until a producer hands an item or the
+        /// timeout is reached.
+        ///
+        /// @param item: element pulled from the fifo
+        /// @param timeout: max amount of time to wait for an item [ms]
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status pull(T& item, unsigned timeout) {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            if(_head && !_consumers) {
+                handoff_helper(item, false);
+                return Status::SUCCESS;
+            }
+            return wait_helper(item, true, _lock, timeout);
+        }
+
+        /// Returns the number of consumers waiting for an item. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return number of waiting consumers
+        int consumers_waiting() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _consumers ? _waiting : 0;
+        }
+
+        /// Returns the number of producers waiting for a consumer. (Thread-safe)
+        ///
+        /// @param no param
+        /// @return number of waiting producers
+        int producers_waiting() {
+            std::unique_lock<std::mutex> _lock(_mutex);
+            return _consumers ? 0 : _waiting;
+        }
+
+        /// Returns the current number of items, always 0.
+        ///
+        /// @param no param
+        /// @return 0
+        int size() const {
+            return 0;
+        }
+
+    protected:
+        /// Moves an item between this thread and the oldest waiting one,
+        /// the mutex must be locked.
+        ///
+        /// The waiter is woken under the lock: once it sees _done it
+        /// returns and its condition variable is gone.
+        ///
+        /// @param item: the item of this thread
+        /// @param to_waiter: the item goes to the waiter (push) or comes from it (pull)
+        /// @return no return
+        void handoff_helper(T& item, bool to_waiter) {
+            Waiter* waiter = _head;
+            _head = waiter->_next;
+            if(!_head)
+                _tail = nullptr;
+            --_waiting;
+            if(to_waiter)
+                *waiter->_item = std::move(item);
+            else
+                item = std::move(*waiter->_item);
+            waiter->_done = true;
+            waiter->_condv.notify_one();
+        }
+
+        /// Appends a waiter, the mutex must be locked and the queue empty
+        /// or of the same kind.
+        void enqueue_helper(Waiter& waiter, bool consumer) {
+            _consumers = consumer;
+            if(_tail)
+                _tail->_next = &waiter;
+            else
+                _head = &waiter;
+            _tail = &waiter;
+            ++_waiting;
+        }
+
+        /// Removes a waiter that timed out, the mutex must be locked.
+        void unlink_helper(Waiter& waiter) {
+            Waiter* prev = nullptr;
+            for(Waiter* w = _head; w != &waiter; w = w->_next)
+                prev = w;
+            if(prev)
+                prev->_next = waiter._next;
+            else
+                _head = waiter._next;
+            if(_tail == &waiter)
+                _tail = prev;
+            --_waiting;
+        }
+
+        /// Waits for the other side until the timeout, the mutex must be locked.
+        ///
+        /// @param item: the item of this thread
+        /// @param consumer: this thread is a consumer
+        /// @param lock: the lock of the mutex
+        /// @param timeout: max amount of time to wait [ms]
+        /// @return either Status::TIMEOUT or Status::SUCCESS
+        Status wait_helper(T& item, bool consumer, std::unique_lock<std::mutex>& lock, unsigned timeout) {
+            auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+            Waiter waiter{&item, false, nullptr};
+            enqueue_helper(waiter, consumer);
+            while(!waiter._done) {
+                if(waiter._condv.wait_until(lock, until)==std::cv_status::timeout && !waiter._done) {
+                    unlink_helper(waiter);
+                    return Status::TIMEOUT;
+                }
+            }
+            return Status::SUCCESS;
+        }
+    };
+};
+
+#endif
@@ -87,8 +87,52 @@ namespace tsFIFO {
                 return _max_size_seconds;
             }
             
+            /// Adds a group of items into the FIFO, all of them or none. (Thread-safe)
+            ///
+            /// The whole duration of the group is reserved under a single
+            /// lock: its items are contiguous in the FIFO. If the group does
+            /// not fit ActionIfFull defines the action to undertake:
+            /// DumpFirstEntry dumps the oldest items to make room for the
+            /// whole group, otherwise nothing is pushed. While an item is
+            /// peeked nothing is dumped: the group is not pushed either.
+            ///
+            /// @param first, last: the range of the items, moved into the fifo
+            /// @return Status::SUCCESS, Status::FULL, or Status::ERROR if the
+            ///         group is longer than the fifo
+            template<typename Iterator>
+            Status push_all_or_nothing(Iterator first, Iterator last) {
+                TimeT duration = TimeT();
+                for(Iterator it = first; it != last; ++it)
+                    duration += (*it)->get_size_seconds();
+                std::unique_lock<std::mutex> _lock(this->_mutex);
+                while(this->_claimed) {
+                    this->_condv.wait(_lock);
+                }
+                if(duration > _max_size_seconds)
+                    return Status::ERROR;
+                Status status = Status::SUCCESS;
+                if(_size_seconds + duration > _max_size_seconds) {
+                    // as in dump_first_helper(), the peeked item cannot be dumped,
+                    // nor the ones behind it without moving it
+                    if(action_if_full == ActionIfFull::Nothing || this->_peeked)
+                        return Status::FULL;
+                    // a floating-point TimeT may not sum back to 0 when empty
+                    while(!this->_queue.empty() && _size_seconds + duration > _max_size_seconds) {
+                        T item = pull_pop_first(); // dump the the oldest item
+                        clear_helper(item);
+                    }
+                    status = Status::FULL;
+                }
+                this->push_range_helper(first, last);
+                _lock.unlock();
+                this->dispatch_helper();
+                return status;
+            }
+
             /// Clear whole FIFO (Thread-safe).
             ///
+            /// Must not be called while an item is claimed or peeked.
+            ///
             /// @param no param
             /// @return no param
             void clear(){
@@ -130,6 +174,14 @@ namespace tsFIFO {
                 this->_queue.push(std::move(item)); 
             }
             
+            /// Accounts the last item once committed
+            ///
+            /// @param no param
+            /// @return no return
+            void commit_last() override {
+                _size_seconds += this->_queue.back()->get_size_seconds();
+            }
+
             /// Checks if FIFO is full.
             ///
             /// @param no param
@@ -0,0 +1,131 @@
+/*	=========================================================================
+	Company:
+	Filename: select.hpp
+	Last modifed:   17.10.2026
+	Description:    Waits on several FIFOs at once until one of them has
+                    an item to pull.
+
+	=========================================================================
+
+	=========================================================================
+*/
+
+#ifndef __SELECT_HPP__
+#define __SELECT_HPP__
+
+#include "FIFO.hpp"
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+namespace tsFIFO {
+
+    inline int select_ready_helper(int) {
+        return -1;
+    }
+
+    /// Index of the first FIFO with an item, or -1.
+    template<typename F, typename... Fs>
+    int select_ready_helper(int index, F& fifo, Fs&... fifos) {
+        if(fifo.is_ready())
+            return index;
+        return select_ready_helper(index + 1, fifos...);
+    }
+
+    inline void select_add_helper(SelectLink*) {}
+
+    template<typename F, typename... Fs>
+    void select_add_helper(SelectLink* link, F& fifo, Fs&... fifos) {
+        fifo.add_selector(*link);
+        select_add_helper(link + 1, fifos...);
+    }
+
+    inline void select_remove_helper(SelectLink*) {}
+
+    template<typename F, typename... Fs>
+    void select_remove_helper(SelectLink* link, F& fifo, Fs&... fifos) {
+        fifo.remove_selector(*link);
+        select_remove_helper(link + 1, fifos...);
+    }
+
+    /// Waits until one of the FIFOs has an item, or until the deadline if any.
+    ///
+    /// The waiter is registered in every FIFO before they are checked: a
+    /// push after the check signals it.
+    template<typename... Fs>
+    int select_wait_helper(const std::chrono::steady_clock::time_point* until, Fs&... fifos) {
+        int ready = select_ready_helper(0, fifos...);
+        if(ready >= 0)
+            return ready;
+        SelectWaiter waiter;
+        waiter._signaled = false;
+        SelectLink links[sizeof...(Fs)];
+        for(SelectLink& link : links)
+            link._waiter = &waiter;
+        select_add_helper(links, fifos...);
+        for(;;) {
+            ready = select_ready_helper(0, fifos...);
+            if(ready >= 0)
+                break;
+            std::unique_lock<std::mutex> _lock(waiter._mutex);
+            if(until) {
+                if(!waiter._condv.wait_until(_lock, *until, [&waiter]{ return waiter._signaled; })) {
+                    _lock.unlock();
+                    // last chance: an item may have come with the deadline
+                    ready = select_ready_helper(0, fifos...);
+                    break;
+                }
+            } else {
+                while(!waiter._signaled)
+                    waiter._condv.wait(_lock);
+            }
+            waiter._signaled = false;
+        }
+        select_remove_helper(links, fifos...);
+        return ready;
+    }
+
+    /// Waits until one of several FIFOs has an item to pull. (Thread-safe)
+    ///
+    /// The FIFOs are given by priority: if several have items the index of
+    /// the first one is returned. select() does not pull: the item may
+    /// have been taken by another consumer meanwhile, pull with a zero
+    /// timeout and call select() again on Status::TIMEOUT. A FIFO and its
+    /// derived classes (sFIFO, DedupFIFO) of any item type can be mixed.
+    ///
+    /// An idle select() costs nothing to the producers but a test of an
+    /// empty list. While it waits, each push to one of the FIFOs wakes it.
+    ///
+    /// Example usage:
+    ///
+    ///     std::unique_ptr<Command> command;
+    ///     std::unique_ptr<Frame> frame;
+    ///     switch( tsFIFO::select(100, control, data) ) {
+    ///         case 0: if( control.pull(command, 0) == tsFIFO::Status::SUCCESS ) run(command); break;
+    ///         case 1: if( data.pull(frame, 0) == tsFIFO::Status::SUCCESS ) encode(frame); break;
+    ///         default: break; // timeout
+    ///     }
+    ///
+    /// @param timeout: max amount of time to wait for an item [ms]
+    /// @param fifos: the FIFOs, the first one has the highest priority
+    /// @return index of a FIFO with an item, or -1 on timeout
+    template<typename F, typename... Fs>
+    int select(unsigned timeout, F& fifo, Fs&... fifos) {
+        const std::chrono::steady_clock::time_point until = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+        return select_wait_helper(&until, fifo, fifos...);
+    }
+
+    /// Waits until one of several FIFOs has an item to pull. (Thread-safe)
+    ///
+    /// As select() with a timeout, but this function blocks until an item
+    /// is available.
+    ///
+    /// @param fifos: the FIFOs, the first one has the highest priority
+    /// @return index of a FIFO with an item
+    template<typename F, typename... Fs>
+    int select(F& fifo, Fs&... fifos) {
+        return select_wait_helper(nullptr, fifo, fifos...);
+    }
+};
+
+#endif
@@ -0,0 +1,271 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_AsyncFIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the fifo
+                    is actually thread-safe using many coroutines resumed
+                    by a few threads. Requires -std=c++20.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "AsyncFIFO.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <vector>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the FIFO
+// Here we keep track of the producer and of the value
+class ITEM {
+	public:
+		int _idx_producer;
+        int _value;
+        ITEM(const int value):_idx_producer(0), _value(value) {}
+		ITEM(const int idx_producer, const int value):_idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+};
+
+// Coroutine started at once and never awaited
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return Task(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// Definition of the FIFOs we use here
+using smallFIFO = tsFIFO::AsyncFIFO<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
+using smallFIFOC = tsFIFO::AsyncFIFO<ITEM*, tsFIFO::ActionIfFull::DumpFirstEntry>;
+using handleFIFO = tsFIFO::FIFO<std::coroutine_handle<>, tsFIFO::ActionIfFull::Nothing>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and of worker threads
+const int Npushes = 10000; // number of items to push
+const int Ncoroutines = 1000; // number of consumer coroutines
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+std::atomic<int> finished(0);
+
+// the executor: the coroutines are resumed by a few worker threads
+handleFIFO ready(Ncoroutines + Nthreads);
+smallFIFO fifo(100, [](std::coroutine_handle<> handle){
+    while(ready.push(handle) == tsFIFO::Status::FULL)
+        usleep(10);
+});
+
+void worker(){
+    for(;;) {
+        std::coroutine_handle<> handle;
+        ready.pull(handle);
+        if(!handle)
+            break;
+        handle.resume();
+    }
+}
+
+// producer thread
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		std::unique_ptr<ITEM> item = std::make_unique<ITEM>(idx_producer, i);
+		while(fifo.push(item) == tsFIFO::Status::FULL)
+            usleep(10);
+	}
+}
+
+// consumer coroutine, an empty item stops it
+Task consumer(){
+	for(;;){
+		std::unique_ptr<ITEM> item = co_await fifo.async_pull();
+        if(!item)
+            break;
+        mtx.lock();
+        verif[item->_idx_producer][item->_value]++;
+        mtx.unlock();
+	}
+    finished++;
+}
+
+Task pull_one(smallFIFO& fifo, int& value){
+    std::unique_ptr<ITEM> item = co_await fifo.async_pull();
+    value = item->_value;
+}
+
+Task push_all(smallFIFO& fifo, int count, int& pushed){
+    for(int i=0; i<count; ++i) {
+        std::unique_ptr<ITEM> item = std::make_unique<ITEM>(i);
+        tsFIFO::Status status = co_await fifo.async_push(item);
+        assert(status==tsFIFO::Status::SUCCESS);
+        ++pushed;
+    }
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the FIFO
+        // ===============================================
+        smallFIFO fifo(2);
+        std::unique_ptr<ITEM> item = std::make_unique<ITEM>(1);
+        fifo.push(item);
+
+        // an item is there, the coroutine does not wait
+        int value = 0;
+        pull_one(fifo, value);
+        assert(value==1);
+
+        // the coroutine waits, the push resumes it inline
+        pull_one(fifo, value);
+        assert(value==1);
+        item = std::make_unique<ITEM>(2);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        assert(value==2);
+        // the item has been given to the coroutine, not stored
+        assert(fifo.size()==0);
+
+        // the producer coroutine waits for room
+        int pushed = 0;
+        push_all(fifo, 4, pushed);
+        assert(pushed==2);
+        assert(fifo.size()==2);
+        fifo.pull(item);
+        assert(item->_value==0);
+        assert(pushed==3);
+        assert(fifo.pull(item, 10)==tsFIFO::Status::SUCCESS);
+        assert(item->_value==1);
+        assert(pushed==4);
+        pull_one(fifo, value);
+        assert(value==2);
+        pull_one(fifo, value);
+        assert(value==3);
+        assert(fifo.size()==0);
+
+        // the items of a group reach the waiting coroutines, and so do the next pushes
+        int got = 0;
+        pull_one(fifo, got);
+        std::vector<std::unique_ptr<ITEM>> group;
+        group.push_back(std::make_unique<ITEM>(4));
+        assert(fifo.push_all_or_nothing(group.begin(), group.end())==tsFIFO::Status::SUCCESS);
+        assert(got==4);
+        int got2 = 0;
+        pull_one(fifo, got2);
+        item = std::make_unique<ITEM>(5);
+        fifo.push(item);
+        assert(got2==5);
+        assert(fifo.size()==0);
+
+        // the item of a committed slot reaches the waiting coroutine
+        pull_one(fifo, got);
+        std::unique_ptr<ITEM>* slot = fifo.claim();
+        *slot = std::make_unique<ITEM>(6);
+        // a coroutine pushing meanwhile is suspended, the thread is not blocked
+        pushed = 0;
+        push_all(fifo, 1, pushed);
+        assert(pushed==0);
+        fifo.commit();
+        assert(got==6);
+        assert(pushed==1);
+        assert(fifo.size()==1);
+
+        // the peeked item is not given, the next one is after release()
+        fifo.peek();
+        item = std::make_unique<ITEM>(7);
+        fifo.push(item);
+        got = 0;
+        pull_one(fifo, got);
+        assert(got==0);
+        fifo.release();
+        assert(got==7);
+        assert(fifo.size()==0);
+
+        // the room made by a subscriber resumes the producer coroutine
+        smallFIFO one(1);
+        pushed = 0;
+        push_all(one, 2, pushed);
+        assert(pushed==1);
+        std::vector<int> values;
+        auto subscription = one.on_item([](std::function<void()> task){ task(); },
+                                        [&values](std::vector<std::unique_ptr<ITEM>>& batch){
+                                            values.push_back(batch[0]->_value);
+                                        });
+        assert(pushed==2);
+        assert(values.size()==2 && values[1]==1);
+        assert(one.size()==0);
+        subscription.reset();
+    }
+    {
+        // ===============================================
+        // C-style pointers
+        // ===============================================
+        smallFIFOC fifo(2);
+        for(int i=0; i<3; ++i) {
+            ITEM* item = new ITEM(i);
+            fifo.push(item);
+        }
+        ITEM* item;
+        fifo.pull(item);
+        assert(item->_value==1);
+        delete item;
+        // deleted by the destructor
+    }
+
+    // ===============================================
+	// Here instead we test if the FIFO is thread-safe
+    // ===============================================
+    std::array<std::thread,Nthreads> workers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i)
+        workers[i] = std::thread(worker);
+    for(int i=0; i<Ncoroutines; ++i)
+        consumer();
+    for(size_t i=0; i<Nthreads; ++i)
+        producers[i] = std::thread(producer,i);
+
+	for(size_t i=0; i<Nthreads; ++i)
+        producers[i].join();
+    for(int i=0; i<Ncoroutines; ++i) {
+        std::unique_ptr<ITEM> stop;
+        while(fifo.push(stop) == tsFIFO::Status::FULL)
+            usleep(10);
+    }
+    while(finished < Ncoroutines)
+        usleep(1000);
+    for(size_t i=0; i<Nthreads; ++i) {
+        std::coroutine_handle<> stop;
+        ready.push(stop);
+    }
+    for(size_t i=0; i<Nthreads; ++i)
+        workers[i].join();
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // every item must be pulled exactly once
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
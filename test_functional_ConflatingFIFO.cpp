@@ -0,0 +1,199 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_ConflatingFIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the fifo
+                    is actually thread-safe using multiple producers
+                    and consumers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "ConflatingFIFO.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the FIFO
+// Here we keep track of the producer and of the update number per key
+class ITEM {
+	public:
+		std::string _key;
+		int _idx_producer;
+        int _value;
+        ITEM(const std::string key, const int value)
+                :_key(key),_idx_producer(0), _value(value) {}
+		ITEM(const std::string key, const int idx_producer, const int value)
+                :_key(key),_idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+        const std::string& get_key(){ return _key; }
+};
+
+// Definition of the FIFOs we use here
+using smallFIFO = tsFIFO::ConflatingFIFO<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
+using smallFIFOC = tsFIFO::ConflatingFIFO<ITEM*, tsFIFO::ActionIfFull::DumpFirstEntry>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and consumers to create
+const int Nkeys = 16; // number of keys per producer
+const int Npushes = 10000; // number of updates per producer
+smallFIFO fifo(Nthreads*Nkeys);
+int last[Nthreads][Nkeys];
+std::mutex mtx;
+
+// producer thread: each producer updates its own keys
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		std::unique_ptr<ITEM> item = std::make_unique<ITEM>(
+            std::to_string(idx_producer) + "." + std::to_string(i % Nkeys), idx_producer, i);
+        // there is always room as there is one slot per key
+		assert(fifo.push(item) == tsFIFO::Status::SUCCESS);
+	}
+}
+
+// consumer thread
+void consumer(){
+	while(1){
+		std::unique_ptr<ITEM> item;
+		if(fifo.pull(item,100) == tsFIFO::Status::SUCCESS) {
+            int key = std::stoi(item->_key.substr(item->_key.find('.') + 1));
+            mtx.lock();
+            // the updates of a key can be skipped but never go back in time
+            assert(item->_value > last[item->_idx_producer][key]);
+            last[item->_idx_producer][key] = item->_value;
+            mtx.unlock();
+        } else {
+            break;
+        }
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the FIFO
+        // ===============================================
+        smallFIFO fifo;
+
+        fifo.set_max_size(3);
+        assert(fifo.get_max_size() == 3);
+
+        std::unique_ptr<ITEM> item = std::make_unique<ITEM>("a", 1);
+        fifo.push(item);
+        item = std::make_unique<ITEM>("b", 2);
+        fifo.push(item);
+        item = std::make_unique<ITEM>("c", 3);
+        fifo.push(item);
+        assert(fifo.is_full()==true);
+
+        // a new key does not fit
+        item = std::make_unique<ITEM>("d", 4);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        // an update of a queued key always does
+        item = std::make_unique<ITEM>("a", 5);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        assert(fifo.size()==3);
+
+        // the update keeps the position of the first item with the same key
+        fifo.pull(item);
+        assert(item->_key=="a" && item->_value==5);
+
+        // "a" is not queued anymore, it goes at the end
+        item = std::make_unique<ITEM>("a", 6);
+        fifo.push(item);
+        item = std::make_unique<ITEM>("c", 7);
+        fifo.push(item);
+        fifo.pull(item);
+        assert(item->_key=="b" && item->_value==2);
+        fifo.pull(item);
+        assert(item->_key=="c" && item->_value==7);
+        fifo.pull(item);
+        assert(item->_key=="a" && item->_value==6);
+
+        // the fifo should be empty now
+        assert(fifo.size()==0);
+        // since the fifo is empty if we call pull we should obtain a timeout
+        assert(fifo.pull(item, 100)==tsFIFO::Status::TIMEOUT);
+
+        // many keys colliding in the hash table
+        fifo.set_max_size(1000);
+        for(int i=0; i<1000; ++i){
+            item = std::make_unique<ITEM>(std::to_string(i), i);
+            fifo.push(item);
+        }
+        for(int i=0; i<1000; i+=3){
+            item = std::make_unique<ITEM>(std::to_string(i), -i);
+            fifo.push(item);
+        }
+        assert(fifo.size()==1000);
+        for(int i=0; i<1000; ++i){
+            fifo.pull(item);
+            assert(item->_key==std::to_string(i));
+            assert(item->_value==((i % 3) ? i : -i));
+        }
+
+        item = std::make_unique<ITEM>("a", 8);
+        fifo.push(item);
+        fifo.clear();
+        assert(fifo.size()==0);
+    }
+    {
+        // ===============================================
+        // with C-style pointers the replaced items are deleted
+        // ===============================================
+        smallFIFOC fifo(2);
+        ITEM* item = new ITEM("a", 1);
+        fifo.push(item);
+        item = new ITEM("a", 2);
+        fifo.push(item);
+        item = new ITEM("b", 3);
+        fifo.push(item);
+        // the oldest item is dumped
+        item = new ITEM("c", 4);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        fifo.pull(item);
+        assert(item->_key=="b");
+        delete item;
+        fifo.pull(item);
+        assert(item->_key=="c");
+        delete item;
+    }
+
+    // ===============================================
+	// Here instead we test if the FIFO is thread-safe
+    // ===============================================
+    for(int i=0; i<Nthreads; ++i)
+        for(int j=0; j<Nkeys; ++j)
+            last[i][j] = -1;
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer);
+        producers[i] = std::thread(producer,i);
+    }
+
+	for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+
+    // the latest update of every key has been delivered
+    for(int i=0; i<Nthreads; ++i)
+        for(int j=0; j<Nkeys; ++j)
+            assert(last[i][j] == Npushes - Nkeys + j);
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
@@ -0,0 +1,169 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_ConsumerPool.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the
+                    pool is actually thread-safe using multiple producers
+                    while it scales.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "ConsumerPool.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the FIFO
+// Here we keep track of the producer and of the value
+class ITEM {
+	public:
+		int _idx_producer;
+        int _value;
+        ITEM(const int value):_idx_producer(0), _value(value) {}
+		ITEM(const int idx_producer, const int value):_idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+};
+
+// Definition of the FIFOs we use here
+using smallFIFO = tsFIFO::FIFO<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
+using smallFIFOC = tsFIFO::FIFO<ITEM*, tsFIFO::ActionIfFull::DumpFirstEntry>;
+using smallPool = tsFIFO::ConsumerPool<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
+using smallPoolC = tsFIFO::ConsumerPool<ITEM*, tsFIFO::ActionIfFull::DumpFirstEntry>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers to create
+const int Npushes = 10000; // number of items to push
+smallFIFO fifo(100);
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+
+// producer thread
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		std::unique_ptr<ITEM> item = std::make_unique<ITEM>(idx_producer, i);
+		while(fifo.push(item) == tsFIFO::Status::FULL)
+            usleep(10);
+	}
+}
+
+// waits until the condition holds, up to 5s
+template<typename F>
+bool eventually(F condition){
+    for(int i=0; i<5000; ++i) {
+        if(condition())
+            return true;
+        usleep(1000);
+    }
+    return false;
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the pool
+        // ===============================================
+        smallFIFO fifo(10000);
+        std::atomic<int> handled(0);
+        smallPool pool(fifo, [&handled](std::unique_ptr<ITEM>& item){
+                if(item->_value < 0)
+                    throw std::runtime_error("bad item");
+                usleep(1000); // slow consumer
+                handled++;
+            }, 1, 4, 5, 10); // 1 to 4 workers, 5ms in queue, sampled every 10ms
+        assert(pool.workers()==1);
+        assert(pool.parked()==0);
+
+        // a backlog: the time in queue grows, workers are added up to the max
+        for(int i=0; i<2000; ++i) {
+            std::unique_ptr<ITEM> item = std::make_unique<ITEM>(i);
+            fifo.push(item);
+        }
+        assert(eventually([&pool]{ return pool.workers()==4; }));
+        assert(pool.sojourn() > 0);
+
+        // idle: the workers are parked down to the min
+        assert(eventually([&fifo, &handled]{ return handled==2000 && fifo.size()==0; }));
+        assert(eventually([&pool]{ return pool.workers()==1; }));
+        assert(pool.parked()==3);
+        assert(pool.processed()==2000);
+
+        // an exception drops the item
+        std::unique_ptr<ITEM> item = std::make_unique<ITEM>(-1);
+        fifo.push(item);
+        assert(eventually([&pool]{ return pool.errors()==1; }));
+
+        // a new backlog wakes the parked workers instead of creating threads
+        for(int i=0; i<2000; ++i) {
+            item = std::make_unique<ITEM>(i);
+            fifo.push(item);
+        }
+        assert(eventually([&pool]{ return pool.workers() > 1; }));
+        assert(pool.workers() + pool.parked() <= 4);
+    }
+    {
+        // ===============================================
+        // C-style pointers
+        // ===============================================
+        smallFIFOC fifoc(10);
+        std::atomic<int> sum(0);
+        {
+            smallPoolC pool(fifoc, [&sum](ITEM*& item){
+                    sum += item->_value;
+                    delete item; // the handler owns the item
+                }, 2, 2);
+            for(int i=0; i<10; ++i) {
+                ITEM* item = new ITEM(i);
+                fifoc.push(item);
+            }
+            assert(eventually([&sum]{ return sum==45; }));
+        }
+    }
+
+    // ===============================================
+	// Here instead we test if the pool is thread-safe
+    // ===============================================
+    std::atomic<int> handled(0);
+    {
+        smallPool pool(fifo, [&handled](std::unique_ptr<ITEM>& item){
+                mtx.lock();
+                verif[item->_idx_producer][item->_value]++;
+                mtx.unlock();
+                handled++;
+            }, 1, Nthreads, 1, 5);
+        std::array<std::thread,Nthreads> producers;
+        for(size_t i=0; i<Nthreads; ++i)
+            producers[i] = std::thread(producer,i);
+        for(size_t i=0; i<Nthreads; ++i)
+            producers[i].join();
+        assert(eventually([&handled]{ return handled==Nthreads*Npushes; }));
+    }
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // every item must be pulled exactly once
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
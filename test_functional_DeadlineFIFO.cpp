@@ -0,0 +1,199 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_DeadlineFIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the fifo
+                    is actually thread-safe using multiple producers
+                    and consumers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "DeadlineFIFO.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+using Clock = std::chrono::steady_clock;
+
+// Test item for the FIFO
+// Here we keep track of the producer, of the value and of the deadline
+class ITEM {
+	public:
+		int _idx_producer;
+        int _value;
+        Clock::time_point _deadline;
+        ITEM(const int value, const int deadline_ms)
+                :_idx_producer(0), _value(value),
+                 _deadline(Clock::now() + std::chrono::milliseconds(deadline_ms)) {}
+		ITEM(const int idx_producer, const int value, const int deadline_ms)
+                :_idx_producer(idx_producer), _value(value),
+                 _deadline(Clock::now() + std::chrono::milliseconds(deadline_ms)) {}
+		~ITEM(){}
+        Clock::time_point get_deadline(){ return _deadline; }
+};
+
+// Definition of the FIFOs we use here
+using smallFIFO = tsFIFO::DeadlineFIFO<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
+using smallFIFOC = tsFIFO::DeadlineFIFO<ITEM*, tsFIFO::ActionIfFull::DumpFirstEntry>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and consumers to create
+const int Npushes = 10000; // number of items to push
+smallFIFO fifo(100);
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+
+// producer thread
+// the deadlines are far enough in the future to never expire
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		std::unique_ptr<ITEM> item = std::make_unique<ITEM>(idx_producer, i, 60000 + (i*7919) % 1000);
+		while(fifo.push(item) == tsFIFO::Status::FULL)
+            usleep(10);
+	}
+}
+
+// consumer thread
+void consumer(){
+	while(1){
+		std::unique_ptr<ITEM> item;
+		if(fifo.pull(item,100) == tsFIFO::Status::SUCCESS) {
+            mtx.lock();
+            verif[item->_idx_producer][item->_value]++;
+            mtx.unlock();
+        } else {
+            break;
+        }
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the FIFO
+        // ===============================================
+        smallFIFO fifo;
+
+        fifo.set_max_size(1000);
+        assert(fifo.get_max_size() == 1000);
+
+        // earliest deadline first
+        std::unique_ptr<ITEM> item;
+        for(int i=0; i<500; ++i){
+            item = std::make_unique<ITEM>(i, 10000 + (i*7919) % 500);
+            fifo.push(item);
+        }
+        Clock::time_point last = Clock::time_point::min();
+        for(int i=0; i<500; ++i){
+            fifo.pull(item);
+            assert(item->_deadline >= last);
+            last = item->_deadline;
+        }
+        assert(fifo.size()==0);
+
+        // the same deadline keeps the push order
+        Clock::time_point deadline = Clock::now() + std::chrono::seconds(10);
+        for(int i=0; i<10; ++i){
+            item = std::make_unique<ITEM>(i, 0);
+            item->_deadline = deadline;
+            fifo.push(item);
+        }
+        for(int i=0; i<10; ++i){
+            fifo.pull(item);
+            assert(item->_value==i);
+        }
+
+        // the expired items are dropped and never pulled
+        item = std::make_unique<ITEM>(1, 10);
+        fifo.push(item);
+        item = std::make_unique<ITEM>(2, 20);
+        fifo.push(item);
+        item = std::make_unique<ITEM>(3, 10000);
+        fifo.push(item);
+        usleep(50000);
+        assert(fifo.size()==3);
+        fifo.pull(item);
+        assert(item->_value==3);
+        assert(fifo.get_expired()==2);
+
+        // since the fifo is empty if we call pull we should obtain a timeout
+        item = std::make_unique<ITEM>(4, 10);
+        fifo.push(item);
+        usleep(20000);
+        assert(fifo.pull(item, 100)==tsFIFO::Status::TIMEOUT);
+        assert(fifo.get_expired()==3);
+        assert(fifo.size()==0);
+
+        // when full, the expired items make room
+        fifo.set_max_size(2);
+        item = std::make_unique<ITEM>(5, 10);
+        fifo.push(item);
+        item = std::make_unique<ITEM>(6, 10000);
+        fifo.push(item);
+        item = std::make_unique<ITEM>(7, 10000);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        usleep(20000);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        assert(fifo.is_full()==true);
+        fifo.clear();
+        assert(fifo.size()==0);
+    }
+    {
+        // ===============================================
+        // with DumpFirstEntry the most urgent item is dumped
+        // ===============================================
+        smallFIFOC fifo(2);
+        ITEM* item = new ITEM(1, 10000);
+        fifo.push(item);
+        item = new ITEM(2, 20000);
+        fifo.push(item);
+        item = new ITEM(3, 30000);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        fifo.pull(item);
+        assert(item->_value==2);
+        delete item;
+        // the remaining item is deleted by the destructor
+    }
+
+    // ===============================================
+	// Here instead we test if the FIFO is thread-safe
+    // ===============================================
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer);
+        producers[i] = std::thread(producer,i);
+    }
+
+	for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // there must be one item only for each cell in the array otherwise the FIFO is broken
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
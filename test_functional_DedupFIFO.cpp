@@ -0,0 +1,212 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_DedupFIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the fifo
+                    is actually thread-safe using multiple producers
+                    and consumers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "DedupFIFO.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the FIFO
+// Here we keep track of the message id and of the producer that pushed it
+class ITEM {
+	public:
+		uint64_t _id;
+		int _idx_producer;
+        ITEM(const uint64_t id):_id(id),_idx_producer(0) {}
+		ITEM(const uint64_t id, const int idx_producer):_id(id),_idx_producer(idx_producer) {}
+		~ITEM(){}
+        uint64_t get_id(){ return _id; }
+};
+
+// Definition of the FIFOs we use here
+using smallFIFO = tsFIFO::DedupFIFO<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
+using smallFIFOC = tsFIFO::DedupFIFO<ITEM*, tsFIFO::ActionIfFull::DumpFirstEntry>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and consumers to create
+const int Nmessages = 10000; // number of distinct messages
+smallFIFO fifo(100, 2*Nmessages, 1e-9);
+int verif[Nmessages] = {0};
+std::mutex mtx;
+
+// producer thread
+// every producer pushes all the messages, as retries of the same delivery
+void producer(int idx_producer){
+	for(int i=0; i<Nmessages; i++){
+		std::unique_ptr<ITEM> item = std::make_unique<ITEM>(i, idx_producer);
+        tsFIFO::Status status;
+        // the FIFO may be full, retry until the message is in or is a duplicate
+		while((status = fifo.push(item)) == tsFIFO::Status::FULL)
+            usleep(10);
+        assert(status == tsFIFO::Status::SUCCESS || status == tsFIFO::Status::DUPLICATE);
+	}
+}
+
+// consumer thread
+void consumer(){
+	while(1){
+		std::unique_ptr<ITEM> item;
+		if(fifo.pull(item,100) == tsFIFO::Status::SUCCESS) {
+            mtx.lock();
+            verif[item->_id]++;
+            mtx.unlock();
+        } else {
+            break;
+        }
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the FIFO
+        // ===============================================
+        smallFIFO fifo(2, 3);
+
+        std::unique_ptr<ITEM> item = std::make_unique<ITEM>(1);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        item = std::make_unique<ITEM>(1);
+        assert(fifo.push(item)==tsFIFO::Status::DUPLICATE);
+        // the duplicate did not take a slot and is left to the caller
+        assert(fifo.size()==1);
+        assert(item->_id==1);
+
+        item = std::make_unique<ITEM>(2);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        // the id of an item that did not fit is not remembered
+        item = std::make_unique<ITEM>(3);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        fifo.pull(item);
+        assert(item->_id==1);
+        // it is still a duplicate once pulled
+        assert(fifo.push(item)==tsFIFO::Status::DUPLICATE);
+        item = std::make_unique<ITEM>(3);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+
+        // the window covers the last 3 pushes at least and 6 at most
+        fifo.pull(item);
+        fifo.pull(item);
+        for(int i=4; i<=9; ++i){
+            item = std::make_unique<ITEM>(i);
+            assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+            fifo.pull(item);
+        }
+        item = std::make_unique<ITEM>(7);
+        assert(fifo.push(item)==tsFIFO::Status::DUPLICATE);
+        item = std::make_unique<ITEM>(1);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+
+        fifo.clear_ids();
+        item = std::make_unique<ITEM>(9);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        assert(fifo.size()==2);
+        fifo.clear();
+        assert(fifo.size()==0);
+    }
+    {
+        // ===============================================
+        // the window can be limited in time
+        // ===============================================
+        smallFIFO fifo(10, 1000, 1e-6, std::chrono::milliseconds(50));
+        std::unique_ptr<ITEM> item = std::make_unique<ITEM>(1);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        item = std::make_unique<ITEM>(1);
+        assert(fifo.push(item)==tsFIFO::Status::DUPLICATE);
+        // two periods later the id is forgotten
+        usleep(60000);
+        item = std::make_unique<ITEM>(2);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        usleep(60000);
+        item = std::make_unique<ITEM>(3);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        item = std::make_unique<ITEM>(1);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+
+        // forgotten as well after two idle periods, without any other push
+        usleep(110000);
+        item = std::make_unique<ITEM>(1);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        // but remembered within a period
+        usleep(20000);
+        item = std::make_unique<ITEM>(1);
+        assert(fifo.push(item)==tsFIFO::Status::DUPLICATE);
+    }
+    {
+        // ===============================================
+        // with DumpFirstEntry the new item enters the FIFO, unless the
+        // oldest one is being read
+        // ===============================================
+        smallFIFOC fifo(1, 10);
+        ITEM* item = new ITEM(1);
+        fifo.push(item);
+        item = new ITEM(2);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        // so its id is remembered
+        ITEM* dup = new ITEM(2);
+        assert(fifo.push(dup)==tsFIFO::Status::DUPLICATE);
+        delete dup;
+        fifo.pull(item);
+        assert(item->_id==2);
+        delete item;
+
+        // the peeked item is not dumped: the new one is refused, its id forgotten
+        item = new ITEM(3);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        fifo.peek();
+        item = new ITEM(4);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        assert(item->_id==4);
+        fifo.release();
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        assert(fifo.size()==1);
+        fifo.pull(item);
+        delete item;
+    }
+
+    // ===============================================
+	// Here instead we test if the FIFO is thread-safe
+    // ===============================================
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer);
+        producers[i] = std::thread(producer,i);
+    }
+
+	for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+
+    for(int i=0; i<Nmessages; ++i){
+        // every message must be delivered exactly once
+#ifdef DEBUG
+        if(verif[i]!=1)
+            std::cout << "verif[" << i << "]=" << verif[i] << " Error\n";
+#endif
+        assert(verif[i]==1);
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
@@ -0,0 +1,190 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_DelayFIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the fifo
+                    is actually thread-safe using multiple producers
+                    and consumers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "DelayFIFO.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+using Clock = std::chrono::steady_clock;
+
+// Test item for the FIFO
+// Here we keep track of the producer, of the value and of the due time
+class ITEM {
+	public:
+		int _idx_producer;
+        int _value;
+        Clock::time_point _due;
+        ITEM(const int value):_idx_producer(0), _value(value) {}
+		ITEM(const int idx_producer, const int value):_idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+};
+
+// Definition of the FIFOs we use here
+using smallFIFO = tsFIFO::DelayFIFO<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
+using smallFIFOC = tsFIFO::DelayFIFO<ITEM*, tsFIFO::ActionIfFull::DumpFirstEntry>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and consumers to create
+const int Npushes = 5000; // number of items to push
+smallFIFO fifo(1000, std::chrono::microseconds(10));
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+
+// producer thread
+// the items are due within 0 to 20ms
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		std::unique_ptr<ITEM> item = std::make_unique<ITEM>(idx_producer, i);
+        item->_due = Clock::now() + std::chrono::microseconds((i*7919) % 20000);
+		while(fifo.push_at(item, item->_due) == tsFIFO::Status::FULL)
+            usleep(10);
+	}
+}
+
+// consumer thread
+void consumer(){
+	while(1){
+		std::unique_ptr<ITEM> item;
+		if(fifo.pull(item,100) == tsFIFO::Status::SUCCESS) {
+            // never delivered early
+            assert(Clock::now() >= item->_due);
+            mtx.lock();
+            verif[item->_idx_producer][item->_value]++;
+            mtx.unlock();
+        } else {
+            break;
+        }
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the FIFO
+        // ===============================================
+        // a 1us tick to go through several levels of the wheel quickly
+        smallFIFO fifo(100, std::chrono::microseconds(1));
+        assert(fifo.get_max_size() == 100);
+
+        // delays from 0 to 300ms, pushed in shuffled order
+        const int N = 50;
+        std::unique_ptr<ITEM> item;
+        Clock::time_point start = Clock::now();
+        for(int i=0; i<N; ++i){
+            int j = (i*7) % N;
+            item = std::make_unique<ITEM>(j);
+            item->_due = start + std::chrono::microseconds(j*j*120);
+            fifo.push_at(item, item->_due);
+        }
+        assert(fifo.size()==N);
+        for(int i=0; i<N; ++i){
+            fifo.pull(item);
+            assert(item->_value==i);
+            assert(Clock::now() >= item->_due);
+        }
+        // the consumer slept until the items were due
+        assert(Clock::now() - start < std::chrono::milliseconds(400));
+
+        // items due at the same time keep the push order
+        Clock::time_point due = Clock::now() + std::chrono::milliseconds(20);
+        for(int i=0; i<5; ++i){
+            item = std::make_unique<ITEM>(i);
+            fifo.push_at(item, due);
+        }
+        for(int i=0; i<5; ++i){
+            fifo.pull(item);
+            assert(item->_value==i);
+        }
+
+        // an item not due yet is not pulled
+        item = std::make_unique<ITEM>(1);
+        fifo.push_after(item, std::chrono::milliseconds(300));
+        item = std::make_unique<ITEM>(2);
+        fifo.push(item);
+        fifo.pull(item);
+        assert(item->_value==2);
+        assert(fifo.pull(item, 100)==tsFIFO::Status::TIMEOUT);
+        assert(fifo.size()==1);
+        assert(fifo.pull(item, 1000)==tsFIFO::Status::SUCCESS);
+        assert(item->_value==1);
+
+        // since the fifo is empty if we call pull we should obtain a timeout
+        assert(fifo.pull(item, 100)==tsFIFO::Status::TIMEOUT);
+
+        fifo.set_max_size(1);
+        item = std::make_unique<ITEM>(3);
+        fifo.push_after(item, std::chrono::seconds(10));
+        item = std::make_unique<ITEM>(4);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        assert(fifo.is_full()==true);
+        fifo.clear();
+        assert(fifo.size()==0);
+    }
+    {
+        // ===============================================
+        // with DumpFirstEntry the item due first is dumped
+        // ===============================================
+        smallFIFOC fifo(2);
+        ITEM* item = new ITEM(1);
+        fifo.push_after(item, std::chrono::seconds(20));
+        item = new ITEM(2);
+        fifo.push_after(item, std::chrono::seconds(10));
+        item = new ITEM(3);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        fifo.pull(item);
+        assert(item->_value==3);
+        delete item;
+        assert(fifo.size()==1);
+        // the remaining item is deleted by the destructor
+    }
+
+    // ===============================================
+	// Here instead we test if the FIFO is thread-safe
+    // ===============================================
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer);
+        producers[i] = std::thread(producer,i);
+    }
+
+	for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // there must be one item only for each cell in the array otherwise the FIFO is broken
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
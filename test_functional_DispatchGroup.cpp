@@ -0,0 +1,193 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_DispatchGroup.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the
+                    group is actually thread-safe using multiple producers
+                    and one consumer per fifo.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "DispatchGroup.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the FIFO
+// Here we keep track of the producer and of the value
+class ITEM {
+	public:
+		int _idx_producer;
+        int _value;
+        ITEM(const int value):_idx_producer(0), _value(value) {}
+		ITEM(const int idx_producer, const int value):_idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+};
+
+// Definition of the groups we use here
+using smallGroup = tsFIFO::DispatchGroup<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
+using smallGroupC = tsFIFO::DispatchGroup<ITEM*, tsFIFO::ActionIfFull::DumpFirstEntry>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and consumers to create
+const int Npushes = 10000; // number of items to push
+smallGroup group(Nthreads, 100);
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+
+// producer thread, half of the items are sticky
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		std::unique_ptr<ITEM> item = std::make_unique<ITEM>(idx_producer, i);
+        if(i % 2)
+            while(group.push(item) == tsFIFO::Status::FULL)
+                usleep(10);
+        else
+            while(group.push(item, i % 16) == tsFIFO::Status::FULL)
+                usleep(10);
+	}
+}
+
+// consumer thread, pulls from its own fifo
+void consumer(int idx_consumer){
+	while(true){
+		std::unique_ptr<ITEM> item;
+		if(group.pull(idx_consumer, item, 100) == tsFIFO::Status::TIMEOUT)
+            break;
+        mtx.lock();
+        verif[item->_idx_producer][item->_value]++;
+        mtx.unlock();
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the group
+        // ===============================================
+        smallGroup group(4, 1000);
+        assert(group.fifos()==4);
+
+        // the load is balanced
+        for(int i=0; i<400; ++i) {
+            std::unique_ptr<ITEM> item = std::make_unique<ITEM>(i);
+            assert(group.push(item)==tsFIFO::Status::SUCCESS);
+        }
+        assert(group.size()==400);
+        for(int i=0; i<4; ++i) {
+            assert(group.size(i) >= 97);
+            assert(group.size(i) <= 103);
+        }
+
+        // pulls only from the given fifo
+        std::unique_ptr<ITEM> item;
+        for(int i=0; i<4; ++i)
+            while(group.pull(i, item, 0)==tsFIFO::Status::SUCCESS);
+        assert(group.size()==0);
+        assert(group.pull(0, item, 10)==tsFIFO::Status::TIMEOUT);
+
+        // a slow worker: fifo 0 is never drained, it gets almost nothing
+        for(int i=0; i<1000; ++i) {
+            item = std::make_unique<ITEM>(i);
+            group.push(item);
+            for(int j=1; j<4; ++j)
+                while(group.pull(j, item, 0)==tsFIFO::Status::SUCCESS);
+        }
+        assert(group.size(0) <= 1);
+        while(group.pull(0, item, 0)==tsFIFO::Status::SUCCESS);
+    }
+    {
+        // sticky keys: the same fifo until it is max_skew items deeper
+        smallGroup group(4, 1000, 4);
+        std::unique_ptr<ITEM> item = std::make_unique<ITEM>(0);
+        group.push(item, std::string("client"));
+        int sticky = -1;
+        for(int i=0; i<4; ++i)
+            if(group.size(i)==1)
+                sticky = i;
+        assert(sticky >= 0);
+        for(int i=1; i<5; ++i) {
+            item = std::make_unique<ITEM>(i);
+            group.push(item, std::string("client"));
+            assert(group.size(sticky)==i + 1);
+        }
+        // 5 items vs an empty fifo: the key moves
+        item = std::make_unique<ITEM>(5);
+        group.push(item, std::string("client"));
+        assert(group.size(sticky)==5);
+        for(int i=0; i<5; ++i) {
+            group.pull(sticky, item);
+            assert(item->_value==i);
+        }
+
+        // full: refused
+        smallGroup one(1, 2);
+        for(int i=0; i<2; ++i) {
+            item = std::make_unique<ITEM>(i);
+            assert(one.push(item)==tsFIFO::Status::SUCCESS);
+        }
+        item = std::make_unique<ITEM>(2);
+        assert(one.push(item, 1)==tsFIFO::Status::FULL);
+        assert(one.size()==2);
+    }
+    {
+        // ===============================================
+        // C-style pointers
+        // ===============================================
+        smallGroupC group(1, 2);
+        for(int i=0; i<3; ++i) {
+            ITEM* item = new ITEM(i);
+            group.push(item);
+        }
+        // the oldest one has been dumped
+        assert(group.size()==2);
+        ITEM* item;
+        group.pull(0, item);
+        assert(item->_value==1);
+        delete item;
+        // deleted by the destructor
+    }
+
+    // ===============================================
+	// Here instead we test if the group is thread-safe
+    // ===============================================
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer,i);
+        producers[i] = std::thread(producer,i);
+    }
+
+	for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+    assert(group.size()==0);
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // every item must be pulled exactly once
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
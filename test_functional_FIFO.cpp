@@ -18,9 +18,14 @@
 #include <vector>
 #include <cassert>
 #include <thread>
+#include <array>
 #include <mutex>
 #include <unistd.h>
 #include <sys/wait.h>
+#include <sys/epoll.h>
+#include <iterator>
+#include <atomic>
+#include <functional>
 #include "FIFO.hpp"
 
 //#define DEBUG 1
@@ -40,6 +45,13 @@ class ITEM {
 		~ITEM(){}
 };
 
+// Counts its destructions, to check who deletes the dumped items
+struct COUNTED {
+    static int destroyed;
+    ~COUNTED(){ ++destroyed; }
+};
+int COUNTED::destroyed = 0;
+
 // Definition of the FIFOs we use here
 using bigFIFO = tsFIFO::FIFO<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
 using smallFIFO = tsFIFO::FIFO<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
@@ -251,6 +263,342 @@ int main(){
         fifo.clear();
         assert(fifo.size()==0);
     }
+    {
+        // ===============================================
+        // items written and read in place
+        // ===============================================
+        smallFIFO fifo(3);
+
+        std::unique_ptr<ITEM>* slot = fifo.claim();
+        assert(slot != nullptr);
+        // a claimed slot is not visible to the consumers
+        assert(fifo.size()==0);
+        std::unique_ptr<ITEM> item;
+        assert(fifo.pull(item, 10)==tsFIFO::Status::TIMEOUT);
+        *slot = std::make_unique<ITEM>("id", 1);
+        fifo.commit();
+        assert(fifo.size()==1);
+
+        std::unique_ptr<ITEM> item2 = std::make_unique<ITEM>("id", 2);
+        fifo.push(item2);
+        slot = fifo.claim();
+        *slot = std::make_unique<ITEM>("id", 3);
+        fifo.commit();
+        // the FIFO is full, nothing to claim
+        assert(fifo.claim() == nullptr);
+
+        std::unique_ptr<ITEM>* head = fifo.peek();
+        assert((*head)->_value==1);
+        // the peeked item is not available to the other consumers
+        assert(fifo.pull(item, 10)==tsFIFO::Status::TIMEOUT);
+        fifo.release();
+        assert(fifo.size()==2);
+
+        fifo.pull(item);
+        assert(item->_value==2);
+        head = fifo.peek(10);
+        assert(head != nullptr && (*head)->_value==3);
+        fifo.release();
+        assert(fifo.size()==0);
+        assert(fifo.peek(10) == nullptr);
+
+        // a push waits for the claimed slot to be committed
+        slot = fifo.claim();
+        std::thread pusher([&fifo](){
+            std::unique_ptr<ITEM> item = std::make_unique<ITEM>("id", 5);
+            fifo.push(item);
+        });
+        usleep(20000);
+        *slot = std::make_unique<ITEM>("id", 4);
+        fifo.commit();
+        pusher.join();
+        fifo.pull(item);
+        assert(item->_value==4);
+        fifo.pull(item);
+        assert(item->_value==5);
+    }
+    {
+        // ===============================================
+        // the oldest item is dumped to make room for a claim
+        // unless it is being read
+        // ===============================================
+        tsFIFO::FIFO<int> fifo(2);
+        int a = 1, b = 2;
+        fifo.push(a);
+        fifo.push(b);
+        int* slot = fifo.claim();
+        assert(slot != nullptr);
+        *slot = 3;
+        fifo.commit();
+        assert(fifo.size()==2);
+
+        int* head = fifo.peek();
+        assert(*head==2);
+        assert(fifo.claim() == nullptr);
+        int c = 4;
+        assert(fifo.push(c)==tsFIFO::Status::FULL);
+        fifo.release();
+        assert(fifo.size()==1);
+        fifo.pull(c);
+        assert(c==3);
+    }
+    {
+        // ===============================================
+        // a group of items is pushed all or nothing
+        // ===============================================
+        smallFIFO fifo(5);
+        std::vector<std::unique_ptr<ITEM>> group;
+        for(int i=0; i<3; ++i)
+            group.push_back(std::make_unique<ITEM>("id", i));
+        assert(fifo.push_all_or_nothing(group.begin(), group.end())==tsFIFO::Status::SUCCESS);
+        assert(fifo.size()==3);
+
+        // the second group does not fit: nothing is pushed
+        std::vector<std::unique_ptr<ITEM>> group2;
+        for(int i=3; i<6; ++i)
+            group2.push_back(std::make_unique<ITEM>("id", i));
+        assert(fifo.push_all_or_nothing(group2.begin(), group2.end())==tsFIFO::Status::FULL);
+        assert(fifo.size()==3);
+        assert(group2[0] && group2[2]);
+        // larger than the fifo
+        std::vector<std::unique_ptr<ITEM>> group3(6);
+        assert(fifo.push_all_or_nothing(group3.begin(), group3.end())==tsFIFO::Status::ERROR);
+
+        std::unique_ptr<ITEM> item;
+        fifo.pull(item);
+        assert(fifo.push_all_or_nothing(group2.begin(), group2.end())==tsFIFO::Status::SUCCESS);
+        for(int i=1; i<6; ++i) {
+            fifo.pull(item);
+            assert(item->_value==i);
+        }
+
+        // the oldest items are dumped to make room for the whole group
+        tsFIFO::FIFO<ITEM*> fifoc(4);
+        for(int i=0; i<3; ++i) {
+            ITEM* itemc = new ITEM("id", i);
+            fifoc.push(itemc);
+        }
+        std::vector<ITEM*> groupc = {new ITEM("id", 3), new ITEM("id", 4), new ITEM("id", 5)};
+        assert(fifoc.push_all_or_nothing(groupc.begin(), groupc.end())==tsFIFO::Status::FULL);
+        assert(fifoc.size()==4);
+        ITEM* itemc;
+        fifoc.pull(itemc);
+        assert(itemc->_value==2);
+        delete itemc;
+        fifoc.clear();
+
+        // push() and push_all_or_nothing() both delete the C-style pointers they dump
+        tsFIFO::FIFO<COUNTED*> fifoe(2);
+        for(int i=0; i<3; ++i) {
+            COUNTED* counted = new COUNTED();
+            fifoe.push(counted);
+        }
+        assert(COUNTED::destroyed==1);
+        std::vector<COUNTED*> groupe = {new COUNTED(), new COUNTED()};
+        assert(fifoe.push_all_or_nothing(groupe.begin(), groupe.end())==tsFIFO::Status::FULL);
+        assert(COUNTED::destroyed==3);
+        for(int i=0; i<2; ++i) {
+            COUNTED* counted;
+            fifoe.pull(counted);
+            delete counted;
+        }
+
+        // the peeked item is never dumped: the group is refused
+        tsFIFO::FIFO<std::unique_ptr<ITEM>> fifop(4);
+        for(int i=0; i<3; ++i) {
+            item = std::make_unique<ITEM>("id", i);
+            fifop.push(item);
+        }
+        std::unique_ptr<ITEM>* head = fifop.peek();
+        std::vector<std::unique_ptr<ITEM>> groupp;
+        for(int i=3; i<6; ++i)
+            groupp.push_back(std::make_unique<ITEM>("id", i));
+        assert(fifop.push_all_or_nothing(groupp.begin(), groupp.end())==tsFIFO::Status::FULL);
+        assert(fifop.size()==3);
+        assert(groupp[0] && groupp[2]);
+        assert((*head)->_value==0);
+        fifop.release(); // removes the peeked item, not another one
+        fifop.pull(item);
+        assert(item->_value==1);
+        assert(fifop.push_all_or_nothing(groupp.begin(), groupp.end())==tsFIFO::Status::SUCCESS);
+        assert(fifop.size()==4);
+        fifop.pull(item);
+        assert(item->_value==2);
+    }
+    {
+        // ===============================================
+        // the groups of concurrent producers are not interleaved
+        // ===============================================
+        const int Ngroups = 1000, Ngroup = 4;
+        smallFIFO fifo(64);
+        std::array<std::thread,4> pushers;
+        for(size_t p=0; p<pushers.size(); ++p) {
+            pushers[p] = std::thread([&fifo, p, Ngroups, Ngroup](){
+                for(int g=0; g<Ngroups; ++g) {
+                    std::vector<std::unique_ptr<ITEM>> group;
+                    for(int i=0; i<Ngroup; ++i)
+                        group.push_back(std::make_unique<ITEM>("id", p, g*Ngroup + i));
+                    while(fifo.push_all_or_nothing(group.begin(), group.end())==tsFIFO::Status::FULL)
+                        usleep(10);
+                }
+            });
+        }
+        std::unique_ptr<ITEM> item;
+        for(size_t n=0; n<pushers.size()*Ngroups; ++n) {
+            fifo.pull(item);
+            int producer = item->_idx_producer, first = item->_value;
+            assert(first % Ngroup == 0);
+            for(int i=1; i<Ngroup; ++i) {
+                fifo.pull(item);
+                assert(item->_idx_producer==producer && item->_value==first + i);
+            }
+        }
+        for(std::thread& pusher : pushers)
+            pusher.join();
+        assert(fifo.size()==0);
+    }
+
+    {
+        // ===============================================
+        // the eventfd is readable while there are items
+        // ===============================================
+        smallFIFO fifo(100);
+        int fd = fifo.get_eventfd();
+        assert(fd >= 0 && fifo.get_eventfd()==fd);
+        int epfd = epoll_create1(0);
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event);
+        assert(epoll_wait(epfd, &event, 1, 0)==0);
+
+        for(int i=0; i<3; ++i) {
+            std::unique_ptr<ITEM> item = std::make_unique<ITEM>("id", i);
+            fifo.push(item);
+        }
+        // a single write for the whole burst
+        assert(epoll_wait(epfd, &event, 1, 0)==1);
+        std::vector<std::unique_ptr<ITEM>> items;
+        assert(fifo.try_pull_bulk(std::back_inserter(items), 2)==2);
+        assert(items[0]->_value==0 && items[1]->_value==1);
+        assert(epoll_wait(epfd, &event, 1, 0)==1);
+        assert(fifo.try_pull_bulk(std::back_inserter(items), 2)==1);
+        assert(items[2]->_value==2);
+        // empty: the eventfd is reset
+        assert(epoll_wait(epfd, &event, 1, 0)==0);
+        assert(fifo.try_pull_bulk(std::back_inserter(items), 2)==0);
+
+        // an event loop thread pulls the items pushed by another thread
+        const int Nitems = 10000;
+        std::thread pusher([&fifo, Nitems](){
+            for(int i=0; i<Nitems; ++i) {
+                std::unique_ptr<ITEM> item = std::make_unique<ITEM>("id", i);
+                while(fifo.push(item)==tsFIFO::Status::FULL)
+                    usleep(10);
+            }
+        });
+        int next = 0;
+        while(next < Nitems) {
+            assert(epoll_wait(epfd, &event, 1, 10000)==1);
+            items.clear();
+            while(fifo.try_pull_bulk(std::back_inserter(items), 16) > 0)
+                ;
+            for(auto& item : items)
+                assert(item->_value==next++);
+        }
+        pusher.join();
+        close(epfd);
+    }
+
+    {
+        // ===============================================
+        // handlers called with the items as they arrive
+        // ===============================================
+        smallFIFO fifo(100);
+        std::vector<int> values;
+        // inline executor: the handler runs in push()
+        auto subscription = fifo.on_item([](std::function<void()> task){ task(); },
+                                         [&values](std::vector<std::unique_ptr<ITEM>>& batch){
+                                             assert(batch.size()==1);
+                                             values.push_back(batch[0]->_value);
+                                         });
+        for(int i=0; i<3; ++i) {
+            std::unique_ptr<ITEM> item = std::make_unique<ITEM>("id", i);
+            fifo.push(item);
+        }
+        assert(values.size()==3 && values[0]==0 && values[2]==2);
+        assert(fifo.size()==0);
+        subscription->cancel();
+        std::unique_ptr<ITEM> item = std::make_unique<ITEM>("id", 3);
+        fifo.push(item);
+        assert(values.size()==3 && fifo.size()==1);
+
+        // the items already there are given to a new subscriber, in batches
+        item = std::make_unique<ITEM>("id", 4);
+        fifo.push(item);
+        std::vector<size_t> batches;
+        subscription = fifo.on_item([](std::function<void()> task){ task(); },
+                                    [&batches](std::vector<std::unique_ptr<ITEM>>& batch){
+                                        batches.push_back(batch.size());
+                                    }, 8);
+        assert(batches.size()==1 && batches[0]==2);
+        subscription.reset();
+
+        // an inline executor does not recurse once per batch
+        tsFIFO::FIFO<int> many(100000);
+        for(int i=0; i<100000; ++i)
+            many.push(i);
+        int expected = 0;
+        auto drain = many.on_item([](std::function<void()> task){ task(); },
+                                  [&expected](std::vector<int>& batch){
+                                      assert(batch[0]==expected);
+                                      ++expected;
+                                  });
+        assert(expected==100000 && many.size()==0);
+        drain.reset();
+
+        // a pool of 2 threads runs 4 subscribers, one call at a time each
+        tsFIFO::FIFO<std::function<void()>, tsFIFO::ActionIfFull::Nothing> tasks(1000);
+        std::array<std::thread,2> pool;
+        for(std::thread& thread : pool) {
+            thread = std::thread([&tasks](){
+                std::function<void()> task;
+                while(tasks.pull(task, 200) == tsFIFO::Status::SUCCESS)
+                    task();
+            });
+        }
+        const int Nitems = 10000;
+        std::vector<int> received(Nitems, 0);
+        std::array<std::atomic<int>,4> running;
+        std::vector<std::shared_ptr<smallFIFO::Subscription>> subscriptions;
+        for(size_t i=0; i<running.size(); ++i) {
+            running[i] = 0;
+            subscriptions.push_back(fifo.on_item(
+                [&tasks](std::function<void()> task){
+                    while(tasks.push(task) == tsFIFO::Status::FULL)
+                        usleep(10);
+                },
+                [&, i](std::vector<std::unique_ptr<ITEM>>& batch){
+                    assert(++running[i] == 1);
+                    assert(batch.size() >= 1 && batch.size() <= 16);
+                    mtx.lock();
+                    for(auto& item : batch)
+                        received[item->_value]++;
+                    mtx.unlock();
+                    --running[i];
+                }, 16));
+        }
+        for(int i=0; i<Nitems; ++i) {
+            std::unique_ptr<ITEM> item = std::make_unique<ITEM>("id", i);
+            while(fifo.push(item) == tsFIFO::Status::FULL)
+                usleep(10);
+        }
+        for(std::thread& thread : pool)
+            thread.join();
+        for(int i=0; i<Nitems; ++i)
+            assert(received[i]==1);
+        subscriptions.clear();
+    }
 
     // ===============================================
 	// Here instead we test if the FIFO is thread-safe
@@ -0,0 +1,233 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_FairFIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the fifo
+                    is actually thread-safe using multiple producers
+                    and consumers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "FairFIFO.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the FIFO
+// Here we keep track of the flow, of the producer and of the value
+class ITEM {
+	public:
+        std::string _flow;
+		int _idx_producer;
+        int _value;
+        ITEM(const std::string flow, const int value):_flow(flow), _idx_producer(0), _value(value) {}
+		ITEM(const std::string flow, const int idx_producer, const int value)
+                :_flow(flow), _idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+        const std::string& get_flow(){ return _flow; }
+};
+
+// Definition of the FIFOs we use here
+using smallFIFO = tsFIFO::FairFIFO<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
+using smallFIFOC = tsFIFO::FairFIFO<ITEM*, tsFIFO::ActionIfFull::DumpFirstEntry>;
+
+// Exposes the number of flows kept by the FIFO
+template<tsFIFO::ActionIfFull action_if_full>
+class probeFIFO : public tsFIFO::FairFIFO<ITEM*, action_if_full> {
+    public:
+        using tsFIFO::FairFIFO<ITEM*, action_if_full>::FairFIFO;
+        size_t flows() { return this->_flows.size(); }
+};
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and consumers to create
+const int Npushes = 10000; // number of items to push
+smallFIFO fifo(100, 10);
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+
+// producer thread
+// each producer pushes into 3 flows
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		std::unique_ptr<ITEM> item = std::make_unique<ITEM>(
+            std::to_string(idx_producer) + "." + std::to_string(i % 3), idx_producer, i);
+		while(fifo.push(item) == tsFIFO::Status::FULL)
+            usleep(10);
+	}
+}
+
+// consumer thread
+void consumer(){
+	while(1){
+		std::unique_ptr<ITEM> item;
+		if(fifo.pull(item,100) == tsFIFO::Status::SUCCESS) {
+            mtx.lock();
+            verif[item->_idx_producer][item->_value]++;
+            mtx.unlock();
+        } else {
+            break;
+        }
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the FIFO
+        // ===============================================
+        smallFIFO fifo(100, 10);
+        assert(fifo.get_max_size() == 100);
+
+        // B gets two items per round, A one
+        fifo.set_flow("B", 2, 10);
+        std::unique_ptr<ITEM> item;
+        for(int i=1; i<=6; ++i){
+            item = std::make_unique<ITEM>("A", i);
+            fifo.push(item);
+            item = std::make_unique<ITEM>("B", i);
+            fifo.push(item);
+        }
+        assert(fifo.size()==12);
+        assert(fifo.size("A")==6);
+        const char* flows[] = {"A","B","B","A","B","B","A","B","B","A","A","A"};
+        const int values[] = {1,1,2,2,3,4,3,5,6,4,5,6};
+        for(int i=0; i<12; ++i){
+            fifo.pull(item);
+            assert(item->_flow==flows[i] && item->_value==values[i]);
+        }
+
+        // since the fifo is empty if we call pull we should obtain a timeout
+        assert(fifo.pull(item, 100)==tsFIFO::Status::TIMEOUT);
+
+        // a noisy flow fills its own queue only
+        for(int i=0; i<10; ++i){
+            item = std::make_unique<ITEM>("noisy", i);
+            assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        }
+        item = std::make_unique<ITEM>("noisy", 10);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        item = std::make_unique<ITEM>("quiet", 0);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        // and the quiet one is served right after the first noisy item
+        fifo.pull(item);
+        assert(item->_flow=="noisy");
+        fifo.pull(item);
+        assert(item->_flow=="quiet");
+
+        fifo.set_max_size(9);
+        assert(fifo.is_full()==true);
+        fifo.clear();
+        assert(fifo.size()==0);
+        assert(fifo.size("noisy")==0);
+    }
+    {
+        // ===============================================
+        // with DumpFirstEntry the longest flow pays when the FIFO is full
+        // ===============================================
+        smallFIFOC fifo(4, 4);
+        ITEM* item = new ITEM("A", 1);
+        fifo.push(item);
+        item = new ITEM("A", 2);
+        fifo.push(item);
+        item = new ITEM("A", 3);
+        fifo.push(item);
+        item = new ITEM("B", 1);
+        fifo.push(item);
+        item = new ITEM("B", 2);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        assert(fifo.size("A")==2);
+        assert(fifo.size("B")==2);
+        fifo.pull(item);
+        assert(item->_flow=="A" && item->_value==2);
+        delete item;
+        // the remaining items are deleted by the destructor
+    }
+    {
+        // ===============================================
+        // the idle flows are forgotten, unless they were set
+        // ===============================================
+        probeFIFO<tsFIFO::ActionIfFull::DumpFirstEntry> fifo(1000, 1);
+        fifo.set_flow("set", 2, 1);
+        ITEM* item;
+        for(int i=0; i<100; ++i){
+            item = new ITEM(std::to_string(i), i);
+            fifo.push(item);
+        }
+        assert(fifo.flows()==101);
+        for(int i=0; i<50; ++i){
+            fifo.pull(item);
+            delete item;
+        }
+        assert(fifo.flows()==51);
+        // a flow full of one item dumps it and stays
+        item = new ITEM("50", 0);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        assert(fifo.flows()==51);
+        fifo.clear();
+        assert(fifo.flows()==1);
+        assert(fifo.size("set")==0);
+
+        // a flow emptied to make room is forgotten
+        probeFIFO<tsFIFO::ActionIfFull::DumpFirstEntry> one(1, 1);
+        item = new ITEM("A", 0);
+        one.push(item);
+        item = new ITEM("B", 0);
+        assert(one.push(item)==tsFIFO::Status::FULL);
+        assert(one.flows()==1 && one.size("B")==1);
+
+        // nor is a flow created for an item refused
+        probeFIFO<tsFIFO::ActionIfFull::Nothing> full(1, 1);
+        item = new ITEM("A", 0);
+        full.push(item);
+        for(int i=0; i<1000; ++i) {
+            item = new ITEM(std::to_string(i), i);
+            assert(full.push(item)==tsFIFO::Status::FULL);
+            delete item;
+        }
+        assert(full.flows()==1);
+    }
+
+    // ===============================================
+	// Here instead we test if the FIFO is thread-safe
+    // ===============================================
+    fifo.set_flow("0.0", 3, 20);
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer);
+        producers[i] = std::thread(producer,i);
+    }
+
+	for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // there must be one item only for each cell in the array otherwise the FIFO is broken
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
@@ -0,0 +1,194 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_LIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the lifo
+                    is actually thread-safe using multiple producers
+                    and consumers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "LIFO.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the LIFO
+// Here we keep track of the producer and of the value
+class ITEM {
+	public:
+		int _idx_producer;
+        int _value;
+        ITEM(const int value):_idx_producer(0), _value(value) {}
+		ITEM(const int idx_producer, const int value):_idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+};
+
+// Definition of the LIFOs we use here
+using smallLIFO = tsFIFO::LIFO<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
+using smallLIFOC = tsFIFO::LIFO<ITEM*, tsFIFO::ActionIfFull::DumpFirstEntry>;
+using lockfreeLIFO = tsFIFO::LIFO<ITEM*, tsFIFO::ActionIfFull::Nothing>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and consumers to create
+const int Npushes = 10000; // number of items to push
+lockfreeLIFO lifo(100);
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+
+// producer thread
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		ITEM* item = new ITEM(idx_producer, i);
+		while(lifo.push(item) == tsFIFO::Status::FULL)
+            usleep(10);
+	}
+}
+
+// consumer thread
+void consumer(){
+	while(true){
+		ITEM* item;
+		if(lifo.pull(item, 100) == tsFIFO::Status::TIMEOUT)
+            break;
+        mtx.lock();
+        verif[item->_idx_producer][item->_value]++;
+        mtx.unlock();
+        delete item;
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the LIFO
+        // ===============================================
+        smallLIFO lifo(3);
+        for(int i=1; i<=3; ++i) {
+            std::unique_ptr<ITEM> item = std::make_unique<ITEM>(i);
+            assert(lifo.push(item)==tsFIFO::Status::SUCCESS);
+        }
+        assert(lifo.size()==3);
+        assert(lifo.is_full()==true);
+        std::unique_ptr<ITEM> item = std::make_unique<ITEM>(4);
+        assert(lifo.push(item)==tsFIFO::Status::FULL);
+        assert(item->_value==4);
+
+        // the newest item comes first
+        lifo.pull(item);
+        assert(item->_value==3);
+        lifo.pull(item);
+        assert(item->_value==2);
+        assert(lifo.pull(item, 10)==tsFIFO::Status::SUCCESS);
+        assert(item->_value==1);
+        assert(lifo.pull(item, 10)==tsFIFO::Status::TIMEOUT);
+        assert(lifo.size()==0);
+
+        lifo.set_max_size(5);
+        assert(lifo.get_max_size()==5);
+    }
+    {
+        // ===============================================
+        // C-style pointers: the bottom item is dumped
+        // ===============================================
+        smallLIFOC lifo(3);
+        for(int i=1; i<=4; ++i) {
+            ITEM* item = new ITEM(i);
+            lifo.push(item);
+        }
+        assert(lifo.size()==3);
+        ITEM* item;
+        lifo.pull(item);
+        assert(item->_value==4);
+        delete item;
+        lifo.pull(item);
+        assert(item->_value==3);
+        delete item;
+        lifo.pull(item);
+        assert(item->_value==2);
+        delete item;
+        item = new ITEM(5);
+        lifo.push(item);
+        lifo.clear();
+        assert(lifo.size()==0);
+    }
+    {
+        // ===============================================
+        // lock-free stack of C-style pointers
+        // ===============================================
+        lockfreeLIFO lifo(2);
+        ITEM* a = new ITEM(1);
+        ITEM* b = new ITEM(2);
+        ITEM* c = new ITEM(3);
+        assert(lifo.push(a)==tsFIFO::Status::SUCCESS);
+        assert(lifo.push(b)==tsFIFO::Status::SUCCESS);
+        assert(lifo.is_full()==true);
+        assert(lifo.push(c)==tsFIFO::Status::FULL);
+        assert(lifo.size()==2);
+        ITEM* item;
+        lifo.pull(item);
+        assert(item==b);
+        assert(lifo.push(c)==tsFIFO::Status::SUCCESS);
+        lifo.pull(item);
+        assert(item==c);
+        lifo.pull(item);
+        assert(item==a);
+        assert(lifo.pull(item, 10)==tsFIFO::Status::TIMEOUT);
+
+        // a waiting consumer is woken by a push
+        std::thread waiter([&lifo](){
+            ITEM* item;
+            lifo.pull(item);
+            assert(item->_value==2);
+        });
+        usleep(20000);
+        lifo.push(b);
+        waiter.join();
+        lifo.push(a);
+        lifo.push(c);
+        lifo.clear();
+        delete b;
+    }
+
+    // ===============================================
+	// Here instead we test if the LIFO is thread-safe
+    // ===============================================
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer);
+        producers[i] = std::thread(producer,i);
+    }
+
+	for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // every item must be pulled exactly once
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
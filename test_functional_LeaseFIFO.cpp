@@ -0,0 +1,224 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_LeaseFIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the fifo
+                    is actually thread-safe using multiple producers
+                    and consumers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "LeaseFIFO.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <vector>
+#include <atomic>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the FIFO
+// Here we keep track of the producer and of the value
+class ITEM {
+	public:
+		int _idx_producer;
+        int _value;
+        ITEM(const int value):_idx_producer(0), _value(value) {}
+		ITEM(const int idx_producer, const int value):_idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+};
+
+// Definition of the FIFOs we use here
+using smallFIFO = tsFIFO::LeaseFIFO<std::shared_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
+using smallFIFOC = tsFIFO::LeaseFIFO<ITEM*, tsFIFO::ActionIfFull::DumpFirstEntry>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and consumers to create
+const int Npushes = 10000; // number of items to push
+smallFIFO fifo(100, std::chrono::milliseconds(20));
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+
+// producer thread
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		std::shared_ptr<ITEM> item = std::make_shared<ITEM>(idx_producer, i);
+		while(fifo.push(item) == tsFIFO::Status::FULL)
+            usleep(10);
+	}
+}
+
+// consumer thread
+// one item in 100 is "lost" by the consumer and must come back;
+// the acks are sent 8 at a time, or when there is nothing to do
+void consumer(){
+    std::vector<smallFIFO::Ticket> tickets;
+    int n = 0, idle = 0;
+	while(idle < 10){
+		std::shared_ptr<ITEM> item;
+        smallFIFO::Ticket ticket;
+		if(fifo.pull_lease(item, ticket, 10) == tsFIFO::Status::SUCCESS) {
+            idle = 0;
+            if(++n % 100 == 0)
+                continue;
+            mtx.lock();
+            verif[item->_idx_producer][item->_value]++;
+            mtx.unlock();
+            tickets.push_back(ticket);
+            if(tickets.size() < 8)
+                continue;
+        } else {
+            ++idle;
+        }
+        fifo.ack_batch(tickets.data(), tickets.size());
+        tickets.clear();
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the FIFO
+        // ===============================================
+        smallFIFO fifo(3, std::chrono::milliseconds(50));
+        assert(fifo.get_max_size() == 3);
+
+        std::shared_ptr<ITEM> item;
+        for(int i=1; i<=3; ++i){
+            item = std::make_shared<ITEM>(i);
+            assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        }
+        item = std::make_shared<ITEM>(4);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+
+        smallFIFO::Ticket t1, t2, t3;
+        fifo.pull_lease(item, t1);
+        assert(item->_value==1);
+        fifo.pull_lease(item, t2);
+        assert(item->_value==2);
+        // the leased items still count
+        assert(fifo.size()==3);
+        assert(fifo.size_leased()==2);
+        assert(fifo.is_full()==true);
+
+        assert(fifo.ack(t1)==tsFIFO::Status::SUCCESS);
+        // a ticket is good for one ack
+        assert(fifo.ack(t1)==tsFIFO::Status::ERROR);
+        assert(fifo.size()==2);
+
+        // the lease of 2 expires and it is delivered again before 3
+        usleep(60000);
+        fifo.pull_lease(item, t3);
+        assert(item->_value==2);
+        assert(fifo.get_redelivered()==1);
+        // the first lease is not valid anymore
+        assert(fifo.ack(t2)==tsFIFO::Status::ERROR);
+        assert(fifo.ack(t3)==tsFIFO::Status::SUCCESS);
+
+        fifo.pull_lease(item, t1);
+        assert(item->_value==3);
+        // a consumer waiting for an item gets the expired one
+        assert(fifo.pull_lease(item, t2, 1000)==tsFIFO::Status::SUCCESS);
+        assert(item->_value==3);
+        smallFIFO::Ticket batch[] = {t1, t2};
+        assert(fifo.ack_batch(batch, 2)==1);
+        assert(fifo.size()==0);
+
+        // since the fifo is empty if we call pull_lease we should obtain a timeout
+        assert(fifo.pull_lease(item, t1, 100)==tsFIFO::Status::TIMEOUT);
+
+        item = std::make_shared<ITEM>(5);
+        fifo.push(item);
+        fifo.pull_lease(item, t1);
+        item = std::make_shared<ITEM>(6);
+        fifo.push(item);
+        fifo.clear();
+        assert(fifo.size()==0);
+        assert(fifo.ack(t1)==tsFIFO::Status::ERROR);
+    }
+    {
+        // consumers blocked without timeout wake up when a lease expires
+        smallFIFO fifo(10, std::chrono::milliseconds(100));
+        std::atomic<int> pulled(0);
+        std::array<std::thread,2> waiters;
+        for(std::thread& waiter : waiters) {
+            waiter = std::thread([&fifo, &pulled](){
+                std::shared_ptr<ITEM> item;
+                smallFIFO::Ticket ticket;
+                fifo.pull_lease(item, ticket); // never acked
+                assert(item->_value==7);
+                ++pulled;
+            });
+        }
+        usleep(20000);
+        std::shared_ptr<ITEM> item = std::make_shared<ITEM>(7);
+        fifo.push(item);
+        for(int i=0; i<100 && pulled < 2; ++i)
+            usleep(10000);
+        assert(pulled==2);
+        assert(fifo.get_redelivered()==1);
+        for(std::thread& waiter : waiters)
+            waiter.join();
+    }
+    {
+        // ===============================================
+        // with C-style pointers the items are deleted once acked
+        // ===============================================
+        smallFIFOC fifo(2, std::chrono::seconds(10));
+        ITEM* item = new ITEM(1);
+        fifo.push(item);
+        item = new ITEM(2);
+        fifo.push(item);
+        smallFIFOC::Ticket ticket;
+        fifo.pull_lease(item, ticket);
+        assert(item->_value==1);
+        // the leased item is not dumped
+        item = new ITEM(3);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        assert(fifo.ack(ticket)==tsFIFO::Status::SUCCESS);
+        fifo.pull_lease(item, ticket);
+        assert(item->_value==3);
+        // the leased item is deleted by the destructor
+    }
+
+    // ===============================================
+	// Here instead we test if the FIFO is thread-safe
+    // ===============================================
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer);
+        producers[i] = std::thread(producer,i);
+    }
+
+	for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+
+    assert(fifo.get_redelivered() > 0);
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // every item must be processed, the lost ones after their redelivery
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]>=1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
@@ -0,0 +1,206 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_MessageFIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the fifo
+                    is actually thread-safe using multiple producers
+                    and consumers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "MessageFIFO.hpp"
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// counts the live messages so we can check that all are destroyed
+std::atomic<int> alive(0);
+
+// Test messages for the FIFO
+struct Start {
+    int _idx_producer;
+    int _value;
+    Start(int idx_producer, int value) : _idx_producer(idx_producer), _value(value) { ++alive; }
+    Start(Start&& other) : _idx_producer(other._idx_producer), _value(other._value) { ++alive; }
+    ~Start(){ --alive; }
+};
+
+struct Stop {
+    int _idx_producer;
+    int _value;
+    std::string _reason;
+    Stop(int idx_producer, int value, const std::string& reason)
+        : _idx_producer(idx_producer), _value(value), _reason(reason) { ++alive; }
+    Stop(Stop&& other)
+        : _idx_producer(other._idx_producer), _value(other._value), _reason(std::move(other._reason)) { ++alive; }
+    ~Stop(){ --alive; }
+};
+
+struct alignas(16) Frame {
+    double _pixels[32];
+    Frame(bool fail) { if(fail) throw std::runtime_error("bad frame"); ++alive; }
+    Frame(Frame&& other) { ++alive; }
+    ~Frame(){ --alive; }
+};
+
+using MyFIFO = tsFIFO::MessageFIFO<Start, Stop, Frame>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and consumers to create
+const int Npushes = 10000; // number of messages to send
+MyFIFO fifo(16*1024);
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+
+struct Verifier {
+    void operator()(Start& msg) { count(msg._idx_producer, msg._value); }
+    void operator()(Stop& msg) {
+        assert(msg._reason == std::to_string(msg._value));
+        count(msg._idx_producer, msg._value);
+    }
+    void operator()(Frame& msg) { assert(false); }
+    void count(int idx_producer, int value) {
+        mtx.lock();
+        verif[idx_producer][value]++;
+        mtx.unlock();
+    }
+};
+
+// producer thread
+void producer(int idx_producer){
+    for(int i=0; i<Npushes; i++){
+        if(i % 2)
+            while(fifo.emplace_for<Start>(100, idx_producer, i) != tsFIFO::Status::SUCCESS)
+                ;
+        else
+            while(fifo.emplace_for<Stop>(100, idx_producer, i, std::to_string(i)) != tsFIFO::Status::SUCCESS)
+                ;
+    }
+}
+
+// consumer thread
+void consumer(){
+    Verifier verifier;
+    while(fifo.consume(verifier, 100) == tsFIFO::Status::SUCCESS)
+        ;
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the FIFO
+        // ===============================================
+        MyFIFO fifo(1024);
+
+        assert(fifo.emplace<Start>(0, 1) == tsFIFO::Status::SUCCESS);
+        assert(fifo.emplace<Stop>(0, 2, "two") == tsFIFO::Status::SUCCESS);
+        assert(fifo.emplace<Frame>(false) == tsFIFO::Status::SUCCESS);
+        assert(fifo.size() == 3);
+        assert(alive == 3);
+
+        // a throwing constructor leaves the FIFO untouched
+        bool thrown = false;
+        try {
+            fifo.emplace<Frame>(true);
+        } catch(std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+        assert(fifo.size() == 3);
+
+        // the messages are dispatched on their type, in order
+        std::string seen;
+        auto visitor = [&](auto& msg){ seen += std::to_string(sizeof(msg)) + " "; };
+        fifo.consume(visitor);
+        assert(seen == std::to_string(sizeof(Start)) + " ");
+        std::string reason;
+        struct {
+            std::string* _reason;
+            void operator()(Start&) {}
+            void operator()(Stop& msg) { *_reason = std::move(msg._reason); }
+            void operator()(Frame&) {}
+        } take_reason{&reason};
+        fifo.consume(take_reason);
+        assert(reason == "two");
+        assert(fifo.size() == 1);
+        assert(alive == 1);
+
+        // the FIFO is full
+        while(fifo.emplace<Start>(0, 3) == tsFIFO::Status::SUCCESS)
+            ;
+        assert(fifo.emplace_for<Start>(100, 0, 3) == tsFIFO::Status::TIMEOUT);
+        int n = fifo.size();
+
+        // the messages are moved into the bigger ring
+        assert(fifo.resize(64) == tsFIFO::Status::FULL);
+        assert(fifo.resize(4096) == tsFIFO::Status::SUCCESS);
+        assert(fifo.get_max_size() == 4096);
+        assert(fifo.size() == n);
+        assert(alive == n);
+        seen.clear();
+        fifo.consume(visitor);
+        assert(seen == std::to_string(sizeof(Frame)) + " ");
+        assert(fifo.emplace<Stop>(0, 4, "four") == tsFIFO::Status::SUCCESS);
+
+        // since the fifo is not empty we should not obtain a timeout
+        assert(fifo.consume(visitor, 100) == tsFIFO::Status::SUCCESS);
+
+        fifo.clear();
+        assert(fifo.size() == 0);
+        assert(alive == 0);
+        // since the fifo is empty if we call consume we should obtain a timeout
+        assert(fifo.consume(visitor, 100) == tsFIFO::Status::TIMEOUT);
+
+        // the remaining messages are destroyed with the FIFO
+        fifo.emplace<Stop>(0, 5, "five");
+
+        // a message bigger than the FIFO
+        MyFIFO tiny(sizeof(Frame));
+        assert(tiny.emplace<Frame>(false) == tsFIFO::Status::ERROR);
+    }
+    assert(alive == 0);
+
+    // ===============================================
+    // Here instead we test if the FIFO is thread-safe
+    // ===============================================
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer);
+        producers[i] = std::thread(producer,i);
+    }
+
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // there must be one message only for each cell in the array otherwise the FIFO is broken
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+    assert(alive == 0);
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
@@ -0,0 +1,169 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_OrderedStage.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the stage
+                    is actually thread-safe using multiple producers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "OrderedStage.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the stage
+// Here we keep track of the producer and of the value
+class ITEM {
+	public:
+		int _idx_producer;
+        int _value;
+        ITEM(const int value):_idx_producer(0), _value(value) {}
+		ITEM(const int idx_producer, const int value):_idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+};
+
+// the processing takes longer for some items so that they finish out of order
+std::unique_ptr<ITEM> square(std::unique_ptr<ITEM>& item){
+    if(item->_value % 7 == 0)
+        usleep(100);
+    item->_value = item->_value * item->_value;
+    return std::move(item);
+}
+
+// Definition of the stages we use here
+using Stage = tsFIFO::OrderedStage<std::unique_ptr<ITEM>, std::unique_ptr<ITEM>>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers to create
+const int Npushes = 5000; // number of items to push
+Stage stage(square, 4, 32);
+int verif[Nthreads][Npushes] = {{0}};
+int last[Nthreads];
+std::mutex mtx;
+
+// producer thread
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		std::unique_ptr<ITEM> item = std::make_unique<ITEM>(idx_producer, i);
+		stage.push(item);
+	}
+}
+
+// consumer thread
+void consumer(){
+	while(1){
+		std::unique_ptr<ITEM> item;
+		if(stage.pull(item,100) == tsFIFO::Status::SUCCESS) {
+            mtx.lock();
+            int value = 0;
+            while(value * value < item->_value)
+                ++value;
+            // the results of a producer come in the order of its items
+            assert(value > last[item->_idx_producer]);
+            last[item->_idx_producer] = value;
+            verif[item->_idx_producer][value]++;
+            mtx.unlock();
+        } else {
+            break;
+        }
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the stage
+        // ===============================================
+        tsFIFO::OrderedStage<int, std::string> stage(
+            [](int& value){
+                // the first items are the slowest
+                usleep((10 - value) * 2000);
+                if(value == 5)
+                    throw std::runtime_error("five");
+                return std::to_string(value);
+            }, 4, 4);
+        assert(stage.get_max_size() == 4);
+
+        std::thread pusher([&stage](){
+            for(int i=0; i<10; ++i)
+                stage.push(i);
+        });
+        std::string result;
+        for(int i=0; i<10; ++i){
+            if(i == 5) {
+                bool thrown = false;
+                try {
+                    stage.pull(result);
+                } catch(const std::runtime_error& e) {
+                    thrown = true;
+                }
+                assert(thrown);
+                continue;
+            }
+            stage.pull(result);
+            assert(result == std::to_string(i));
+            // the window bounds the number of items in the stage
+            assert(stage.size() <= 4);
+        }
+        pusher.join();
+        assert(stage.size() == 0);
+
+        // since the stage is empty if we call pull we should obtain a timeout
+        assert(stage.pull(result, 100)==tsFIFO::Status::TIMEOUT);
+
+        // the window is full while the oldest item is not pulled
+        int value = 9;
+        for(int i=0; i<4; ++i)
+            assert(stage.push(value, 1000)==tsFIFO::Status::SUCCESS);
+        assert(stage.push(value, 100)==tsFIFO::Status::TIMEOUT);
+        stage.pull(result);
+        assert(stage.push(value, 100)==tsFIFO::Status::SUCCESS);
+        // the destructor waits for the items being processed
+    }
+
+    // ===============================================
+	// Here instead we test if the stage is thread-safe
+    // ===============================================
+    for(int i=0; i<Nthreads; ++i)
+        last[i] = -1;
+    // a single consumer, the order of the results is lost between several ones
+    std::thread consumer_thread(consumer);
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        producers[i] = std::thread(producer,i);
+    }
+
+	for(size_t i=0; i<Nthreads; ++i){
+        producers[i].join();
+    }
+    consumer_thread.join();
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // there must be one item only for each cell in the array otherwise the stage is broken
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
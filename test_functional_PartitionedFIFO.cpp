@@ -0,0 +1,217 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_PartitionedFIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the fifo
+                    is actually thread-safe using multiple producers
+                    and consumers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "PartitionedFIFO.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the FIFO
+// Here we keep track of the key, of the producer and of the value
+class ITEM {
+	public:
+        int _key;
+		int _idx_producer;
+        int _value;
+        ITEM(const int key, const int value):_key(key), _idx_producer(0), _value(value) {}
+		ITEM(const int key, const int idx_producer, const int value)
+                :_key(key), _idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+        int get_key(){ return _key; }
+};
+
+// Definition of the FIFOs we use here
+using smallFIFO = tsFIFO::PartitionedFIFO<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
+using smallFIFOC = tsFIFO::PartitionedFIFO<ITEM*, tsFIFO::ActionIfFull::DumpFirstEntry>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and consumers to create
+const int Nkeys = 8; // number of keys per producer
+const int Npushes = 10000; // number of items to push
+smallFIFO fifo(6, 50);
+int verif[Nthreads][Npushes] = {{0}};
+int last[Nthreads][Nkeys];
+std::mutex mtx;
+
+// producer thread
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		std::unique_ptr<ITEM> item = std::make_unique<ITEM>(idx_producer*Nkeys + i % Nkeys, idx_producer, i);
+		while(fifo.push(item) == tsFIFO::Status::FULL)
+            usleep(10);
+	}
+}
+
+// consumer thread
+void consumer(){
+	while(1){
+        smallFIFO::Lease lease;
+		if(fifo.acquire(lease, 100) == tsFIFO::Status::SUCCESS) {
+            std::unique_ptr<ITEM> item;
+            // a few items at a time, then the lane goes back
+            for(int n=0; n<10 && lease.pull(item) == tsFIFO::Status::SUCCESS; ++n){
+                mtx.lock();
+                int key = item->_key % Nkeys;
+                // the items with the same key come in order
+                assert(item->_value > last[item->_idx_producer][key]);
+                last[item->_idx_producer][key] = item->_value;
+                verif[item->_idx_producer][item->_value]++;
+                mtx.unlock();
+            }
+        } else {
+            break;
+        }
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the FIFO
+        // ===============================================
+        smallFIFO fifo(2, 3);
+        assert(fifo.lanes() == 2);
+
+        // two keys in different lanes
+        int a = 0, b = 1;
+        while(fifo.lane_of(b) == fifo.lane_of(a))
+            ++b;
+
+        smallFIFO::Lease lease;
+        // nothing to lease
+        assert(fifo.acquire(lease, 100)==tsFIFO::Status::TIMEOUT);
+        assert(!lease);
+
+        std::unique_ptr<ITEM> item;
+        for(int i=0; i<3; ++i){
+            item = std::make_unique<ITEM>(a, i);
+            assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        }
+        item = std::make_unique<ITEM>(a, 3);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        item = std::make_unique<ITEM>(b, 10);
+        fifo.push(item);
+        assert(fifo.size()==4);
+
+        smallFIFO::Lease first = fifo.acquire();
+        smallFIFO::Lease second = fifo.acquire();
+        assert(first && second);
+        assert(first.lane() != second.lane());
+        // all the non-empty lanes are leased
+        assert(fifo.acquire(lease, 100)==tsFIFO::Status::TIMEOUT);
+
+        smallFIFO::Lease& la = (first.lane() == fifo.lane_of(a)) ? first : second;
+        for(int i=0; i<3; ++i){
+            assert(la.pull(item)==tsFIFO::Status::SUCCESS);
+            assert(item->_key==a && item->_value==i);
+        }
+        assert(la.pull(item)==tsFIFO::Status::TIMEOUT);
+        assert(la.pull(item, 100)==tsFIFO::Status::TIMEOUT);
+
+        // the holder gets the items pushed into its lane meanwhile
+        std::thread pusher([&fifo,a](){
+            usleep(20000);
+            std::unique_ptr<ITEM> item = std::make_unique<ITEM>(a, 4);
+            fifo.push(item);
+        });
+        assert(la.pull(item, 1000)==tsFIFO::Status::SUCCESS);
+        assert(item->_value==4);
+        pusher.join();
+
+        // a released lane with items can be leased again
+        second.release();
+        first.release();
+        assert(!first && !second);
+        assert(fifo.acquire(lease, 100)==tsFIFO::Status::SUCCESS);
+        assert(lease.lane()==fifo.lane_of(b));
+        assert(lease.pull(item)==tsFIFO::Status::SUCCESS);
+        assert(item->_value==10);
+
+        // an idle consumer is woken by a push
+        std::thread waiter([&fifo,a](){
+            smallFIFO::Lease lease = fifo.acquire();
+            std::unique_ptr<ITEM> item;
+            assert(lease.pull(item)==tsFIFO::Status::SUCCESS);
+            assert(item->_value==5);
+        });
+        usleep(20000);
+        item = std::make_unique<ITEM>(a, 5);
+        fifo.push(item);
+        waiter.join();
+
+        assert(fifo.size()==0);
+        item = std::make_unique<ITEM>(a, 6);
+        fifo.push(item);
+        fifo.clear();
+        assert(fifo.size()==0);
+    }
+    {
+        // ===============================================
+        // with C-style pointers the dumped items are deleted
+        // ===============================================
+        smallFIFOC fifo(1, 1);
+        ITEM* item = new ITEM(1, 1);
+        fifo.push(item);
+        item = new ITEM(2, 2);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        smallFIFOC::Lease lease = fifo.acquire();
+        lease.pull(item);
+        assert(item->_value==2);
+        delete item;
+        item = new ITEM(3, 3);
+        fifo.push(item);
+        // the remaining item is deleted by the destructor
+    }
+
+    // ===============================================
+	// Here instead we test if the FIFO is thread-safe
+    // ===============================================
+    for(int i=0; i<Nthreads; ++i)
+        for(int j=0; j<Nkeys; ++j)
+            last[i][j] = -1;
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer);
+        producers[i] = std::thread(producer,i);
+    }
+
+	for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // there must be one item only for each cell in the array otherwise the FIFO is broken
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
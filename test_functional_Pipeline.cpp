@@ -0,0 +1,265 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_Pipeline.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the
+                    pipeline is actually thread-safe using multiple workers
+                    per stage.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "Pipeline.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <stdexcept>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the pipeline
+// Here we keep track of the producer and of the value
+class ITEM {
+	public:
+		int _idx_producer;
+        int _value;
+        ITEM(const int value):_idx_producer(0), _value(value) {}
+		ITEM(const int idx_producer, const int value):_idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+};
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of workers per stage
+const int Npushes = 10000; // number of items to push
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the pipeline
+        // ===============================================
+
+        // one worker per node keeps the order
+        int next = 0;
+        int expected = 0;
+        tsFIFO::Pipeline pipeline = tsFIFO::source<int>([&next](int& value){
+                value = next++;
+                return value < 100;
+            })
+            >> tsFIFO::stage([](int& value){ return std::to_string(value); }, 1, 4)
+            >> tsFIFO::stage([](std::string& text){ return std::make_unique<ITEM>(std::stoi(text)); }, 1, 4)
+            >> tsFIFO::sink([&expected](std::unique_ptr<ITEM>& item){
+                assert(item->_value==expected);
+                ++expected;
+            });
+        pipeline.run();
+        assert(expected==100);
+
+        std::vector<tsFIFO::StageStats> stats = pipeline.stats();
+        assert(stats.size()==4);
+        assert(stats[0]._name=="source");
+        assert(stats[1]._name=="stage 1");
+        assert(stats[3]._name=="sink");
+        for(const tsFIFO::StageStats& stat : stats) {
+            assert(stat._processed==100);
+            assert(stat._errors==0);
+            assert(stat._depth==0);
+        }
+        assert(stats[0]._capacity==0);
+        assert(stats[1]._capacity==4);
+        assert(stats[3]._capacity==64);
+        assert(stats[1]._workers==1);
+    }
+    {
+        // backpressure: a slow sink stops the source once the edges are full
+        std::atomic<int> produced(0);
+        std::atomic<bool> go(false);
+        tsFIFO::Pipeline pipeline = tsFIFO::source<int>([&produced](int& value){
+                value = produced++;
+                return true; // endless
+            })
+            >> tsFIFO::stage([](int& value){ return value; }, 1, 2)
+            >> tsFIFO::sink([&go](int&){
+                while(!go)
+                    usleep(100);
+            }, 1, 2);
+        pipeline.start();
+        usleep(50000);
+        // 2 in each edge, 1 in the stage, 1 in the sink, 1 in the source
+        assert(produced <= 7);
+        std::vector<tsFIFO::StageStats> stats = pipeline.stats();
+        assert(stats[1]._depth==2);
+        assert(stats[2]._depth==2);
+
+        // close() stops the source, the items in flight are drained
+        pipeline.close();
+        go = true;
+        pipeline.wait();
+        stats = pipeline.stats();
+        assert(stats[0]._processed==stats[2]._processed);
+        assert(stats[2]._depth==0);
+    }
+    {
+        // an exception drops the item, closes the pipeline and is rethrown by wait()
+        int next = 0;
+        int sunk = 0;
+        tsFIFO::Pipeline pipeline = tsFIFO::source<int>([&next](int& value){
+                value = next++;
+                return true;
+            })
+            >> tsFIFO::stage([](int& value){
+                if(value==10)
+                    throw std::runtime_error("bad item");
+                return value;
+            }, 1)
+            >> tsFIFO::sink([&sunk](int&){ ++sunk; });
+        bool thrown = false;
+        try {
+            pipeline.run();
+        } catch(const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+        std::vector<tsFIFO::StageStats> stats = pipeline.stats();
+        assert(stats[1]._errors==1);
+        assert(sunk==static_cast<int>(stats[1]._processed));
+        assert(sunk>=10);
+    }
+    {
+        // an exception thrown by the source stops it, the items produced are drained
+        int next = 0;
+        int sunk = 0;
+        tsFIFO::Pipeline pipeline = tsFIFO::source<int>([&next](int& value){
+                if(next==10)
+                    throw std::runtime_error("no more input");
+                value = next++;
+                return true;
+            })
+            >> tsFIFO::sink([&sunk](int&){ ++sunk; });
+        bool thrown = false;
+        try {
+            pipeline.run();
+        } catch(const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+        std::vector<tsFIFO::StageStats> stats = pipeline.stats();
+        assert(stats[0]._errors==1);
+        assert(stats[0]._processed==10);
+        assert(sunk==10);
+    }
+    {
+        // fusible stages run on the threads of the next stage, without edges
+        int next = 0;
+        int expected = 0;
+        std::thread::id stage_thread, fused_thread, sink_thread;
+        tsFIFO::Pipeline pipeline = tsFIFO::source<int>([&next](int& value){
+                value = next++;
+                return value < 100;
+            })
+            >> tsFIFO::fuse([](int& value){ return value + 1; })
+            >> tsFIFO::fuse([](int& value){ return std::to_string(value); })
+            >> tsFIFO::stage([&stage_thread](std::string& text){
+                stage_thread = std::this_thread::get_id();
+                return std::stoi(text) * 2;
+            }, 1)
+            >> tsFIFO::fuse([&fused_thread](int& value){
+                fused_thread = std::this_thread::get_id();
+                return std::make_unique<ITEM>(value);
+            })
+            >> tsFIFO::sink([&expected, &sink_thread](std::unique_ptr<ITEM>& item){
+                sink_thread = std::this_thread::get_id();
+                assert(item->_value==(expected + 1) * 2);
+                ++expected;
+            });
+        pipeline.run();
+        assert(expected==100);
+        assert(fused_thread==sink_thread);
+        assert(fused_thread!=stage_thread);
+        std::vector<tsFIFO::StageStats> stats = pipeline.stats();
+        assert(stats.size()==3);
+        assert(stats[1]._processed==100);
+        assert(stats[2]._processed==100);
+    }
+    {
+        // source straight to sink, the destructor closes and joins
+        std::atomic<int> sunk(0);
+        tsFIFO::Pipeline pipeline = tsFIFO::source<int>([](int& value){
+                value = 1;
+                return true;
+            })
+            >> tsFIFO::sink([&sunk](int& value){ sunk += value; });
+        pipeline.start();
+        while(sunk < 10)
+            usleep(100);
+    }
+    {
+        // ===============================================
+        // C-style pointers
+        // ===============================================
+        int next = 0;
+        int sum = 0;
+        tsFIFO::Pipeline pipeline = tsFIFO::source<ITEM*>([&next](ITEM*& item){
+                if(next == 10)
+                    return false;
+                item = new ITEM(next++);
+                return true;
+            })
+            >> tsFIFO::stage([](ITEM*& item){
+                item->_value *= 2;
+                return item;
+            }, 2)
+            >> tsFIFO::sink([&sum](ITEM*& item){
+                sum += item->_value;
+                delete item;
+            });
+        pipeline.run();
+        assert(sum==90);
+    }
+
+    // ===============================================
+	// Here instead we test if the pipeline is thread-safe
+    // ===============================================
+    std::atomic<int> next(0);
+    tsFIFO::Pipeline pipeline = tsFIFO::source<std::unique_ptr<ITEM>>([&next](std::unique_ptr<ITEM>& item){
+            int i = next++;
+            if(i >= Nthreads*Npushes)
+                return false;
+            item = std::make_unique<ITEM>(i / Npushes, i % Npushes);
+            return true;
+        })
+        >> tsFIFO::stage([](std::unique_ptr<ITEM>& item){ return std::move(item); }, Nthreads, 16)
+        >> tsFIFO::fuse([](std::unique_ptr<ITEM>& item){ return std::move(item); })
+        >> tsFIFO::stage([](std::unique_ptr<ITEM>& item){ return std::move(item); }, Nthreads, 16)
+        >> tsFIFO::sink([](std::unique_ptr<ITEM>& item){
+            mtx.lock();
+            verif[item->_idx_producer][item->_value]++;
+            mtx.unlock();
+        }, Nthreads, 16);
+    pipeline.run();
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // every item must go through exactly once
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
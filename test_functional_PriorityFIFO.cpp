@@ -0,0 +1,198 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_PriorityFIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the fifo
+                    is actually thread-safe using multiple producers
+                    and consumers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "PriorityFIFO.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the FIFO
+// Here we keep track of the producer and of the value
+class ITEM {
+	public:
+		int _idx_producer;
+        int _value;
+        ITEM(const int value):_idx_producer(0), _value(value) {}
+		ITEM(const int idx_producer, const int value):_idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+};
+
+// Definition of the FIFOs we use here
+using smallFIFO = tsFIFO::PriorityFIFO<std::unique_ptr<ITEM>, 3>;
+using smallFIFOC = tsFIFO::PriorityFIFO<ITEM*, 64>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and consumers to create
+const int Npushes = 10000; // number of items to push
+smallFIFO fifo(10, tsFIFO::ActionIfFull::Nothing);
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+
+// producer thread
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		std::unique_ptr<ITEM> item = std::make_unique<ITEM>(idx_producer, i);
+		while(fifo.push(item, i % 3) == tsFIFO::Status::FULL)
+            usleep(10);
+	}
+}
+
+// consumer thread
+void consumer(){
+	while(1){
+		std::unique_ptr<ITEM> item;
+		if(fifo.pull(item,100) == tsFIFO::Status::SUCCESS) {
+            mtx.lock();
+            verif[item->_idx_producer][item->_value]++;
+            mtx.unlock();
+        } else {
+            break;
+        }
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the FIFO
+        // ===============================================
+        smallFIFO fifo(3);
+        assert(fifo.get_max_size(0) == 3);
+        assert(fifo.is_empty());
+
+        std::unique_ptr<ITEM> item = std::make_unique<ITEM>(1);
+        assert(fifo.push(item, 3)==tsFIFO::Status::ERROR);
+        fifo.push(item, 2);
+        item = std::make_unique<ITEM>(2);
+        fifo.push(item, 1);
+        item = std::make_unique<ITEM>(3);
+        fifo.push(item, 2);
+        item = std::make_unique<ITEM>(4);
+        fifo.push(item, 0);
+        assert(fifo.size()==4);
+        assert(fifo.size(2)==2);
+        assert(!fifo.is_empty());
+
+        // highest level first, in order within a level
+        fifo.pull(item);
+        assert(item->_value==4);
+        fifo.pull(item);
+        assert(item->_value==2);
+        fifo.pull(item);
+        assert(item->_value==1);
+        fifo.pull(item);
+        assert(item->_value==3);
+        assert(fifo.is_empty());
+        // since the fifo is empty if we call pull we should obtain a timeout
+        assert(fifo.pull(item, 100)==tsFIFO::Status::TIMEOUT);
+
+        // each level has its own size and action
+        fifo.set_level(1, 1, tsFIFO::ActionIfFull::Nothing);
+        item = std::make_unique<ITEM>(5);
+        fifo.push(item, 1);
+        item = std::make_unique<ITEM>(6);
+        assert(fifo.push(item, 1)==tsFIFO::Status::FULL);
+        assert(item->_value==6);
+        assert(fifo.is_full(1));
+        for(int i=7; i<=10; ++i){
+            item = std::make_unique<ITEM>(i);
+            fifo.push(item, 2);
+        }
+        // the oldest items of level 2 have been dumped
+        assert(fifo.size(2)==3);
+        fifo.pull(item);
+        assert(item->_value==5);
+        fifo.pull(item);
+        assert(item->_value==8);
+        fifo.clear();
+        assert(fifo.size()==0);
+
+        // with aging the low levels are served once every 3 pulls
+        fifo.set_level(0, 100, tsFIFO::ActionIfFull::Nothing);
+        fifo.set_aging(3);
+        for(int i=0; i<10; ++i){
+            item = std::make_unique<ITEM>(0);
+            fifo.push(item, 0);
+        }
+        item = std::make_unique<ITEM>(2);
+        fifo.push(item, 2);
+        item = std::make_unique<ITEM>(2);
+        fifo.push(item, 2);
+        const int expected[] = {0,0,0,2,0,0,0,2,0,0};
+        for(int i=0; i<10; ++i){
+            fifo.pull(item);
+            assert(item->_value==expected[i]);
+        }
+    }
+    {
+        // ===============================================
+        // with C-style pointers the dumped items are deleted
+        // ===============================================
+        smallFIFOC fifo(1);
+        ITEM* item = new ITEM(1);
+        fifo.push(item, 63);
+        item = new ITEM(2);
+        assert(fifo.push(item, 63)==tsFIFO::Status::FULL);
+        item = new ITEM(3);
+        fifo.push(item, 0);
+        fifo.pull(item);
+        assert(item->_value==3);
+        delete item;
+        fifo.pull(item);
+        assert(item->_value==2);
+        delete item;
+        item = new ITEM(4);
+        fifo.push(item, 5);
+        // the remaining item is deleted by the destructor
+    }
+
+    // ===============================================
+	// Here instead we test if the FIFO is thread-safe
+    // ===============================================
+    fifo.set_aging(100);
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer);
+        producers[i] = std::thread(producer,i);
+    }
+
+	for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // there must be one item only for each cell in the array otherwise the FIFO is broken
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
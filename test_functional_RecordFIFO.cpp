@@ -0,0 +1,202 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_RecordFIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the fifo
+                    is actually thread-safe using multiple producers
+                    and consumers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "RecordFIFO.hpp"
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and consumers to create
+const int Npushes = 10000; // number of records to write & read
+tsFIFO::RecordFIFO fifo(64*1024);
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+
+// the length of the records goes from 40 bytes to 9 KB
+size_t record_size(int i){
+    return 40 + (i*7919) % 9000;
+}
+
+// producer thread
+// The record is: [idx_producer][value][value & 0xFF repeated]
+void producer(int idx_producer){
+    for(int i=0; i<Npushes; i++){
+        tsFIFO::RecordFIFO::Span span;
+        size_t n = record_size(i);
+        while(fifo.reserve(n, span, 100) != tsFIFO::Status::SUCCESS)
+            ;
+        std::memcpy(span.data, &idx_producer, sizeof(int));
+        std::memcpy(span.data + sizeof(int), &i, sizeof(int));
+        std::memset(span.data + 2*sizeof(int), i & 0xFF, n - 2*sizeof(int));
+        fifo.commit();
+    }
+}
+
+// consumer thread
+void consumer(){
+    while(1){
+        tsFIFO::RecordFIFO::ConstSpan record;
+        if(fifo.read(record, 100) == tsFIFO::Status::SUCCESS) {
+            int idx_producer, value;
+            std::memcpy(&idx_producer, record.data, sizeof(int));
+            std::memcpy(&value, record.data + sizeof(int), sizeof(int));
+            assert(record.size == record_size(value));
+            for(size_t j=2*sizeof(int); j<record.size; ++j)
+                assert(static_cast<unsigned char>(record.data[j]) == (value & 0xFF));
+            fifo.release();
+            mtx.lock();
+            verif[idx_producer][value]++;
+            mtx.unlock();
+        } else {
+            break;
+        }
+    }
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the FIFO
+        // ===============================================
+        tsFIFO::RecordFIFO fifo(8*tsFIFO::RecordFIFO::ALIGNMENT - 1);
+
+        // the size is rounded up to the alignment
+        const size_t A = tsFIFO::RecordFIFO::ALIGNMENT;
+        assert(fifo.get_max_size() == 8*A);
+
+        tsFIFO::RecordFIFO::Span span;
+        // a record bigger than the FIFO can never fit
+        assert(fifo.reserve(8*A, span) == tsFIFO::Status::ERROR);
+
+        // each record takes one header plus its payload rounded up to A
+        assert(fifo.reserve(5, span) == tsFIFO::Status::SUCCESS);
+        assert(span.size == 5);
+        std::memcpy(span.data, "hello", 5);
+        fifo.commit();
+
+        assert(fifo.reserve(3*A, span) == tsFIFO::Status::SUCCESS);
+        std::memcpy(span.data, "world", 5);
+        // only 5 of the reserved bytes are used
+        fifo.commit(5);
+        assert(fifo.size() == 2);
+        assert(fifo.size_bytes() == 4*A);
+
+        assert(fifo.reserve(2*A, span) == tsFIFO::Status::SUCCESS);
+        std::memset(span.data, 'x', 2*A);
+        fifo.commit();
+        assert(fifo.size_bytes() == 7*A);
+
+        tsFIFO::RecordFIFO::ConstSpan record;
+        fifo.read(record);
+        assert(std::string(record.data, record.size) == "hello");
+        const char* first = record.data;
+        fifo.release();
+        assert(fifo.size() == 2);
+
+        // this record does not fit at the end of the ring, it goes to
+        // the beginning and the end is padded
+        assert(fifo.reserve(A, span) == tsFIFO::Status::SUCCESS);
+        assert(span.data == first);
+        std::memset(span.data, 'y', A);
+        fifo.commit();
+        assert(fifo.size_bytes() == 8*A);
+
+        // the FIFO is full now
+        assert(fifo.reserve(0, span) == tsFIFO::Status::FULL);
+        assert(fifo.reserve(0, span, 100) == tsFIFO::Status::TIMEOUT);
+
+        fifo.read(record);
+        assert(std::string(record.data, record.size) == "world");
+        fifo.release();
+        fifo.read(record);
+        assert(record.size == 2*A);
+        assert(record.data[0] == 'x' && record.data[2*A-1] == 'x');
+        fifo.release();
+        // the padding is skipped
+        fifo.read(record);
+        assert(record.size == A);
+        assert(record.data == first);
+        assert(record.data[0] == 'y' && record.data[A-1] == 'y');
+        fifo.release();
+
+        // the fifo should be empty now
+        assert(fifo.size() == 0);
+        assert(fifo.size_bytes() == 0);
+
+        // since the fifo is empty if we call read we should obtain a timeout
+        assert(fifo.read(record, 100) == tsFIFO::Status::TIMEOUT);
+
+        assert(fifo.reserve(0, span) == tsFIFO::Status::SUCCESS);
+        fifo.commit();
+        assert(fifo.size() == 1);
+        fifo.clear();
+        assert(fifo.size() == 0);
+
+        // fill, drain, then a record of the whole ring fits: an empty
+        // ring starts again from the beginning
+        assert(fifo.reserve(3*A, span) == tsFIFO::Status::SUCCESS);
+        fifo.commit();
+        fifo.read(record);
+        fifo.release();
+        assert(fifo.size_bytes() == 0);
+        assert(fifo.reserve(7*A, span) == tsFIFO::Status::SUCCESS);
+        assert(span.data == first);
+        std::memset(span.data, 'z', 7*A);
+        fifo.commit();
+        assert(fifo.size_bytes() == 8*A);
+        fifo.read(record);
+        assert(record.size == 7*A);
+        assert(record.data[0] == 'z' && record.data[7*A-1] == 'z');
+        fifo.release();
+    }
+
+    // ===============================================
+    // Here instead we test if the FIFO is thread-safe
+    // ===============================================
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer);
+        producers[i] = std::thread(producer,i);
+    }
+
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // there must be one record only for each cell in the array otherwise the FIFO is broken
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
@@ -0,0 +1,168 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_SharedFrame.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the
+                    shared items are released correctly by multiple
+                    consumers running concurrently.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "SharedFrame.hpp"
+#include "sFIFO.hpp"
+#include <iostream>
+#include <memory>
+#include <cassert>
+#include <thread>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// counts the live frames so we can check that all are deleted
+std::atomic<int> alive(0);
+
+// Test item for the FIFO
+class FRAME {
+	public:
+        int _value;
+        char _pixels[4096];
+        FRAME(const int value) : _value(value) { ++alive; }
+		~FRAME(){ --alive; }
+        std::chrono::milliseconds get_size_seconds(){ return std::chrono::milliseconds(40); }
+};
+
+using Frame = tsFIFO::SharedFrame<FRAME>;
+using FrameFIFO = tsFIFO::FIFO<Frame, tsFIFO::ActionIfFull::Nothing>;
+
+// the containers move the handles, the reference counts are not touched
+static_assert(std::is_nothrow_move_constructible<Frame>::value, "Frame must be nothrow movable");
+static_assert(std::is_nothrow_move_assignable<Frame>::value, "Frame must be nothrow movable");
+
+// Some global variables for the threads
+const int Nconsumers = 3; // number of consumers, one FIFO each
+const int Npushes = 10000; // number of frames to fan out
+std::array<FrameFIFO, Nconsumers> fifos;
+std::array<long, Nconsumers> sums;
+
+// consumer thread
+void consumer(int idx){
+	while(1){
+		Frame frame;
+		if(fifos[idx].pull(frame,100) == tsFIFO::Status::SUCCESS) {
+            sums[idx] += frame->_value;
+        } else {
+            break;
+        }
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the handles
+        // ===============================================
+        tsFIFO::SharedPool<FRAME> pool(2);
+
+        Frame frame = pool.make(7);
+        assert(frame.use_count() == 1);
+        assert(frame->_value == 7);
+        Frame copy = frame;
+        assert(frame.use_count() == 2);
+        assert(copy.get() == frame.get());
+        Frame moved = std::move(copy);
+        assert(!copy);
+        assert(frame.use_count() == 2);
+        moved.reset();
+        assert(frame.use_count() == 1);
+
+        // more items than blocks in a chunk
+        std::array<Frame, 5> frames;
+        for(int i=0; i<5; ++i)
+            frames[i] = pool.make(i);
+        assert(alive == 6);
+        frames = std::array<Frame, 5>();
+        frame = Frame();
+        assert(alive == 0);
+        // the blocks are recycled
+        frame = pool.adopt(std::unique_ptr<FRAME>(new FRAME(8)));
+        assert(frame->_value == 8);
+    }
+    assert(alive == 0);
+    {
+        // ===============================================
+        // here we test the fan-out into several FIFOs
+        // ===============================================
+        tsFIFO::SharedPool<FRAME> pool;
+        FrameFIFO recorder(1), streamer(2);
+        tsFIFO::sFIFO<Frame, std::chrono::milliseconds, tsFIFO::ActionIfFull::Nothing> analytics(std::chrono::milliseconds(1000));
+
+        Frame frame = pool.make(1);
+        assert(tsFIFO::push_shared(frame, recorder, streamer, analytics) == tsFIFO::Status::SUCCESS);
+        // one reference for each FIFO, plus ours
+        assert(frame.use_count() == 4);
+        assert(analytics.size_seconds() == std::chrono::milliseconds(40));
+
+        // the recorder is full: its reference is given back
+        frame = pool.make(2);
+        assert(tsFIFO::push_shared(frame, recorder, streamer, analytics) == tsFIFO::Status::FULL);
+        assert(frame.use_count() == 3);
+        frame.reset();
+        assert(alive == 2);
+
+        Frame pulled;
+        recorder.pull(pulled);
+        assert(pulled->_value == 1);
+        streamer.pull(pulled);
+        assert(pulled->_value == 1);
+        analytics.pull(pulled);
+        assert(pulled->_value == 1);
+        // the last handle to the first frame
+        assert(pulled.use_count() == 1);
+        pulled.reset();
+        assert(alive == 1);
+
+        streamer.pull(pulled);
+        analytics.pull(pulled);
+        assert(pulled->_value == 2);
+        pulled.reset();
+        assert(alive == 0);
+    }
+    {
+        // ===============================================
+        // Here instead we test the consumers releasing
+        // the frames concurrently
+        // ===============================================
+        tsFIFO::SharedPool<FRAME> pool;
+        std::array<std::thread, Nconsumers> consumers;
+        for(int i=0; i<Nconsumers; ++i){
+            fifos[i].set_max_size(Npushes);
+            sums[i] = 0;
+            consumers[i] = std::thread(consumer, i);
+        }
+        long expected = 0;
+        for(int i=0; i<Npushes; ++i){
+            Frame frame = pool.make(i);
+            expected += i;
+            assert(tsFIFO::push_shared(frame, fifos[0], fifos[1], fifos[2]) == tsFIFO::Status::SUCCESS);
+        }
+        for(int i=0; i<Nconsumers; ++i)
+            consumers[i].join();
+        // every consumer got every frame
+        for(int i=0; i<Nconsumers; ++i)
+            assert(sums[i] == expected);
+        assert(alive == 0);
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
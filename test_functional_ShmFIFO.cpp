@@ -0,0 +1,224 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_ShmFIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests of the shared-memory FIFO. First we test
+                    the functionality within one process, then we transfer
+                    items between processes and finally we kill processes
+                    while they hold a slot.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "ShmFIFO.hpp"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/wait.h>
+
+//#define DEBUG 1
+
+// Test item for the FIFO, written in place by the producers
+struct ITEM {
+    int      _idx_producer;
+    int      _value;
+    uint8_t  _payload[1024];
+};
+
+using spscFIFO = tsFIFO::ShmFIFO<ITEM, tsFIFO::ShmMode::SPSC>;
+using mpmcFIFO = tsFIFO::ShmFIFO<ITEM, tsFIFO::ShmMode::MPMC>;
+
+const int Nproducers = 4; // number of producer processes
+const int Npushes = 10000; // number of push & pull to perform by each producer
+
+template<typename F>
+void producer(F& fifo, int idx_producer){
+    for(int i=0; i<Npushes; ++i){
+        ITEM* item;
+        while(!(item = fifo.claim(100)))
+            ;
+        item->_idx_producer = idx_producer;
+        item->_value = i;
+        item->_payload[i % sizeof(item->_payload)] = static_cast<uint8_t>(i);
+        fifo.commit(item);
+    }
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the FIFO
+        // ===============================================
+        int fd = mpmcFIFO::create_memfd("test");
+        mpmcFIFO fifo(fd, 3);
+        close(fd);
+
+        // the size is rounded up to a power of two
+        assert(fifo.get_max_size() == 4);
+        assert(fifo.size() == 0);
+
+        ITEM item;
+        for(int i=0; i<4; ++i){
+            item._value = i;
+            assert(fifo.push(item) == tsFIFO::Status::SUCCESS);
+        }
+        assert(fifo.is_full()==true);
+        assert(fifo.push(item) == tsFIFO::Status::FULL);
+        assert(fifo.claim() == nullptr);
+
+        const ITEM* head = fifo.peek();
+        assert(head->_value == 0);
+        // the slot is not free until released
+        assert(fifo.claim() == nullptr);
+        fifo.release(head);
+
+        ITEM* slot = fifo.claim();
+        assert(slot != nullptr);
+        slot->_value = 4;
+        fifo.commit(slot);
+
+        for(int i=1; i<5; ++i){
+            fifo.pull(item);
+            assert(item._value == i);
+        }
+        assert(fifo.size() == 0);
+
+        // since the fifo is empty if we call pull we should obtain a timeout
+        assert(fifo.pull(item, 100) == tsFIFO::Status::TIMEOUT);
+        assert(fifo.peek(10) == nullptr);
+    }
+    {
+        // ===============================================
+        // a second process attaching to a named region
+        // ===============================================
+        const std::string name = "/test_functional_ShmFIFO." + std::to_string(getpid());
+        spscFIFO fifo(name, 16);
+
+        pid_t pid = fork();
+        if(pid == 0){
+            spscFIFO child(name, 16);
+            producer(child, 0);
+            _exit(0);
+        }
+        for(int i=0; i<Npushes; ++i){
+            const ITEM* item = fifo.peek();
+            // the items of a single producer arrive in order
+            assert(item->_value == i);
+            assert(item->_payload[i % sizeof(item->_payload)] == static_cast<uint8_t>(i));
+            fifo.release(item);
+        }
+        int status;
+        waitpid(pid, &status, 0);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        spscFIFO::unlink(name);
+    }
+    {
+        // ===============================================
+        // multiple producer processes
+        // ===============================================
+        int fd = mpmcFIFO::create_memfd("test");
+        mpmcFIFO fifo(fd, 64);
+        close(fd);
+
+        pid_t pids[Nproducers];
+        for(int i=0; i<Nproducers; ++i){
+            pids[i] = fork();
+            if(pids[i] == 0){
+                producer(fifo, i);
+                _exit(0);
+            }
+        }
+        int last[Nproducers];
+        for(int i=0; i<Nproducers; ++i)
+            last[i] = -1;
+        for(int i=0; i<Nproducers*Npushes; ++i){
+            ITEM item;
+            assert(fifo.pull(item, 1000) == tsFIFO::Status::SUCCESS);
+            // per-producer order is preserved
+            assert(item._value == last[item._idx_producer] + 1);
+            last[item._idx_producer] = item._value;
+        }
+        for(int i=0; i<Nproducers; ++i)
+            waitpid(pids[i], nullptr, 0);
+        assert(fifo.size() == 0);
+    }
+    {
+        // ===============================================
+        // a producer dies between claim() and commit()
+        // ===============================================
+        int fd = mpmcFIFO::create_memfd("test");
+        mpmcFIFO fifo(fd, 4);
+        close(fd);
+
+        pid_t pid = fork();
+        if(pid == 0){
+            fifo.claim();
+            _exit(0);
+        }
+        waitpid(pid, nullptr, 0);
+
+        ITEM item;
+        item._value = 42;
+        assert(fifo.push(item) == tsFIFO::Status::SUCCESS);
+        // the abandoned slot is skipped
+        assert(fifo.pull(item, 1000) == tsFIFO::Status::SUCCESS);
+        assert(item._value == 42);
+        assert(fifo.size() == 0);
+    }
+    {
+        // ===============================================
+        // a consumer dies between peek() and release()
+        // ===============================================
+        int fd = mpmcFIFO::create_memfd("test");
+        mpmcFIFO fifo(fd, 2);
+        close(fd);
+
+        ITEM item;
+        item._value = 1;
+        fifo.push(item);
+        item._value = 2;
+        fifo.push(item);
+
+        pid_t pid = fork();
+        if(pid == 0){
+            fifo.peek();
+            _exit(0);
+        }
+        waitpid(pid, nullptr, 0);
+
+        // the slot held by the dead consumer is recovered
+        ITEM* slot = fifo.claim(1000);
+        assert(slot != nullptr);
+        slot->_value = 3;
+        fifo.commit(slot);
+        fifo.pull(item);
+        assert(item._value == 2);
+        fifo.pull(item);
+        assert(item._value == 3);
+    }
+    {
+        // ===============================================
+        // the creator dies while initializing the region
+        // ===============================================
+        int fd = mpmcFIFO::create_memfd("test");
+        uint32_t initializing = 1;
+        assert(pwrite(fd, &initializing, sizeof(initializing), 0) == sizeof(initializing));
+
+        // the next process takes the initialization over
+        mpmcFIFO fifo(fd, 4);
+        close(fd);
+        ITEM item;
+        item._value = 7;
+        assert(fifo.push(item) == tsFIFO::Status::SUCCESS);
+        fifo.pull(item);
+        assert(item._value == 7);
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
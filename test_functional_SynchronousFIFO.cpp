@@ -0,0 +1,182 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_SynchronousFIFO.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if the fifo
+                    is actually thread-safe using multiple producers
+                    and consumers.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "SynchronousFIFO.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the FIFO
+// Here we keep track of the producer and of the value
+class ITEM {
+	public:
+		int _idx_producer;
+        int _value;
+        ITEM(const int value):_idx_producer(0), _value(value) {}
+		ITEM(const int idx_producer, const int value):_idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+};
+
+// Definition of the FIFOs we use here
+using smallFIFO = tsFIFO::SynchronousFIFO<std::unique_ptr<ITEM>>;
+using smallFIFOC = tsFIFO::SynchronousFIFO<ITEM*>;
+
+// Some global variables for the threads
+const int Nthreads = 4; // number of producers and consumers to create
+const int Npushes = 10000; // number of items to push
+smallFIFO fifo;
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+
+// producer thread
+// half of the items wait for a consumer, the others retry
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		std::unique_ptr<ITEM> item = std::make_unique<ITEM>(idx_producer, i);
+        if(i % 2) {
+            while(fifo.push(item, 10) == tsFIFO::Status::TIMEOUT)
+                ;
+        } else {
+            while(fifo.push(item) == tsFIFO::Status::FULL)
+                usleep(10);
+        }
+        // the item has been handed over
+        assert(!item);
+	}
+}
+
+// consumer thread
+void consumer(){
+	while(true){
+		std::unique_ptr<ITEM> item;
+		if(fifo.pull(item, 100) == tsFIFO::Status::TIMEOUT)
+            break;
+        mtx.lock();
+        verif[item->_idx_producer][item->_value]++;
+        mtx.unlock();
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of the FIFO
+        // ===============================================
+        smallFIFO fifo;
+        std::unique_ptr<ITEM> item = std::make_unique<ITEM>(1);
+        // no consumer: the item stays with the producer
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        assert(item && item->_value==1);
+        assert(fifo.push(item, 10)==tsFIFO::Status::TIMEOUT);
+        assert(item && item->_value==1);
+        assert(fifo.producers_waiting()==0);
+        std::unique_ptr<ITEM> item2;
+        assert(fifo.pull(item2, 10)==tsFIFO::Status::TIMEOUT);
+        assert(fifo.consumers_waiting()==0);
+
+        // a waiting consumer gets the item directly
+        std::thread waiter([&fifo](){
+            std::unique_ptr<ITEM> item;
+            fifo.pull(item);
+            assert(item->_value==1);
+        });
+        while(fifo.consumers_waiting()==0)
+            usleep(100);
+        assert(fifo.push(item)==tsFIFO::Status::SUCCESS);
+        assert(!item);
+        waiter.join();
+        assert(fifo.size()==0);
+
+        // a waiting producer hands its item to the next consumer
+        std::thread pusher([&fifo](){
+            std::unique_ptr<ITEM> item = std::make_unique<ITEM>(2);
+            assert(fifo.push(item, 10000)==tsFIFO::Status::SUCCESS);
+        });
+        while(fifo.producers_waiting()==0)
+            usleep(100);
+        fifo.pull(item2);
+        assert(item2->_value==2);
+        pusher.join();
+
+        // the consumers are served in arrival order
+        std::unique_ptr<ITEM> first, second;
+        std::thread c1([&fifo, &first](){ fifo.pull(first); });
+        while(fifo.consumers_waiting()<1)
+            usleep(100);
+        std::thread c2([&fifo, &second](){ fifo.pull(second); });
+        while(fifo.consumers_waiting()<2)
+            usleep(100);
+        std::unique_ptr<ITEM> item3 = std::make_unique<ITEM>(3);
+        std::unique_ptr<ITEM> item4 = std::make_unique<ITEM>(4);
+        fifo.push(item3);
+        fifo.push(item4);
+        c1.join();
+        c2.join();
+        assert(first->_value==3 && second->_value==4);
+    }
+    {
+        // ===============================================
+        // C-style pointers
+        // ===============================================
+        smallFIFOC fifo;
+        ITEM* item = new ITEM(5);
+        assert(fifo.push(item)==tsFIFO::Status::FULL);
+        std::thread waiter([&fifo](){
+            ITEM* item = nullptr;
+            assert(fifo.pull(item, 10000)==tsFIFO::Status::SUCCESS);
+            assert(item->_value==5);
+            delete item;
+        });
+        assert(fifo.push(item, 10000)==tsFIFO::Status::SUCCESS);
+        waiter.join();
+    }
+
+    // ===============================================
+	// Here instead we test if the FIFO is thread-safe
+    // ===============================================
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer);
+        producers[i] = std::thread(producer,i);
+    }
+
+	for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // every item must be handed over exactly once
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
@@ -19,6 +19,7 @@
 #include <vector>
 #include <cassert>
 #include <thread>
+#include <array>
 #include <mutex>
 #include <chrono>
 #include <unistd.h>
@@ -44,6 +45,13 @@ class ITEM {
         TimeUnit get_size_seconds(){return TimeUnit(1200);}
 };
 
+// Item whose duration is a floating-point number of seconds
+struct FITEM {
+    double _duration;
+    FITEM(double duration):_duration(duration) {}
+    double get_size_seconds(){return _duration;}
+};
+
 // Definition of the FIFOs we use here
 using bigFIFO = tsFIFO::sFIFO<std::unique_ptr<ITEM>, TimeUnit, tsFIFO::ActionIfFull::Nothing>;
 using smallFIFO = tsFIFO::sFIFO<std::unique_ptr<ITEM>, TimeUnit, tsFIFO::ActionIfFull::Nothing>;
@@ -194,6 +202,77 @@ int main(){
     assert(fifo.size()==0);
     assert(is_equal(fifo.size_seconds(),TimeUnit(0)));
 
+    // the duration of the items written in place is accounted on commit()
+    std::unique_ptr<ITEM>* slot = fifo.claim();
+    *slot = std::make_unique<ITEM>("id", 9);
+    assert(is_equal(fifo.size_seconds(),TimeUnit(0)));
+    fifo.commit();
+    assert(is_equal(fifo.size_seconds(),TimeUnit(1200)));
+    std::unique_ptr<ITEM>* head = fifo.peek();
+    assert((*head)->_value==9);
+    fifo.release();
+    assert(is_equal(fifo.size_seconds(),TimeUnit(0)));
+
+    // the duration of a group is reserved all or nothing
+    std::vector<std::unique_ptr<ITEM>> group;
+    for(int i=0; i<3; ++i)
+        group.push_back(std::make_unique<ITEM>("id", i));
+    assert(fifo.push_all_or_nothing(group.begin(), group.end())==tsFIFO::Status::SUCCESS);
+    assert(is_equal(fifo.size_seconds(),TimeUnit(3600)));
+    std::vector<std::unique_ptr<ITEM>> group2;
+    for(int i=3; i<5; ++i)
+        group2.push_back(std::make_unique<ITEM>("id", i));
+    // 3600 + 2400 > 5000
+    assert(fifo.push_all_or_nothing(group2.begin(), group2.end())==tsFIFO::Status::FULL);
+    assert(fifo.size()==3);
+    fifo.pull(item3);
+    assert(fifo.push_all_or_nothing(group2.begin(), group2.end())==tsFIFO::Status::SUCCESS);
+    assert(is_equal(fifo.size_seconds(),TimeUnit(4800)));
+    fifo.clear();
+
+    // the oldest items are dumped to make room for the whole group
+    tsFIFO::sFIFO<std::unique_ptr<ITEM>, TimeUnit> fifod(TimeUnit(5000));
+    for(int i=0; i<4; ++i) {
+        std::unique_ptr<ITEM> itemd = std::make_unique<ITEM>("id", i);
+        fifod.push(itemd);
+    }
+    std::vector<std::unique_ptr<ITEM>> group3;
+    for(int i=4; i<6; ++i)
+        group3.push_back(std::make_unique<ITEM>("id", i));
+    assert(fifod.push_all_or_nothing(group3.begin(), group3.end())==tsFIFO::Status::FULL);
+    assert(fifod.size()==4);
+    fifod.pull(item3);
+    assert(item3->_value==2);
+
+    // the peeked item is never dumped: the group is refused
+    std::unique_ptr<ITEM>* head3 = fifod.peek();
+    assert((*head3)->_value==3);
+    std::vector<std::unique_ptr<ITEM>> group4;
+    for(int i=6; i<8; ++i)
+        group4.push_back(std::make_unique<ITEM>("id", i));
+    assert(fifod.push_all_or_nothing(group4.begin(), group4.end())==tsFIFO::Status::FULL);
+    assert(group4[0] && group4[1]);
+    assert(fifod.size()==3);
+    fifod.release();
+    fifod.pull(item3);
+    assert(item3->_value==4);
+
+    // a floating-point duration may not sum back to 0: the empty fifo is not popped
+    tsFIFO::sFIFO<std::unique_ptr<FITEM>, double> fifof(1.0);
+    std::unique_ptr<FITEM> itemf = std::make_unique<FITEM>(0.1);
+    fifof.push(itemf);
+    itemf = std::make_unique<FITEM>(0.2);
+    fifof.push(itemf);
+    fifof.pull(itemf);
+    fifof.pull(itemf);
+    double residue = fifof.size_seconds();
+    assert(fifof.size()==0 && residue > 0.0);
+    fifof.set_max_size_seconds(residue);
+    std::vector<std::unique_ptr<FITEM>> groupf;
+    groupf.push_back(std::make_unique<FITEM>(residue));
+    fifof.push_all_or_nothing(groupf.begin(), groupf.end());
+    assert(fifof.size()==1);
+
     // ===============================================
 	// Here instead we test if the FIFO is thread-safe
     // ===============================================
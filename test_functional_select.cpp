@@ -0,0 +1,203 @@
+/*	=========================================================================
+	Company:
+	Filename: test_functional_select.cpp
+	Last modifed:   17.10.2026
+	Description:	Functional tests. Here we test if all the proposed
+                    functionality work as expected. Then we test if select
+                    is actually thread-safe using multiple producers
+                    and consumers on several fifos.
+
+	=========================================================================
+
+	=========================================================================
+*/
+#include "select.hpp"
+#include "sFIFO.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <chrono>
+#include <atomic>
+#include <unistd.h>
+
+//#define DEBUG 1
+
+// Test item for the FIFO
+// Here we keep track of the producer and of the value
+class ITEM {
+	public:
+		int _idx_producer;
+        int _value;
+        ITEM(const int value):_idx_producer(0), _value(value) {}
+		ITEM(const int idx_producer, const int value):_idx_producer(idx_producer), _value(value) {}
+		~ITEM(){}
+        std::chrono::milliseconds get_size_seconds(){return std::chrono::milliseconds(100);}
+};
+
+// Definition of the FIFOs we use here
+using smallFIFO = tsFIFO::FIFO<std::unique_ptr<ITEM>, tsFIFO::ActionIfFull::Nothing>;
+using smallFIFOC = tsFIFO::FIFO<ITEM*, tsFIFO::ActionIfFull::DumpFirstEntry>;
+
+// Some global variables for the threads
+// each producer pushes into the fifo of its own index
+const int Nthreads = 3; // number of producers and consumers to create
+const int Npushes = 10000; // number of items to push
+smallFIFO fifos[Nthreads];
+int verif[Nthreads][Npushes] = {{0}};
+std::mutex mtx;
+
+// producer thread
+void producer(int idx_producer){
+	for(int i=0; i<Npushes; i++){
+		std::unique_ptr<ITEM> item = std::make_unique<ITEM>(idx_producer, i);
+		while(fifos[idx_producer].push(item) == tsFIFO::Status::FULL)
+            usleep(10);
+	}
+}
+
+// consumer thread
+void consumer(){
+	while(true){
+        int ready = tsFIFO::select(100, fifos[0], fifos[1], fifos[2]);
+		if(ready < 0)
+            break;
+		std::unique_ptr<ITEM> item;
+        // another consumer may have been faster
+		if(fifos[ready].pull(item, 0) == tsFIFO::Status::TIMEOUT)
+            continue;
+        assert(item->_idx_producer==ready);
+        mtx.lock();
+        verif[item->_idx_producer][item->_value]++;
+        mtx.unlock();
+	}
+}
+
+int main(){
+    {
+        // ===============================================
+        // here we test the functionality of select
+        // ===============================================
+        smallFIFO control(10);
+        tsFIFO::FIFO<int> data(10);
+        tsFIFO::sFIFO<std::unique_ptr<ITEM>, std::chrono::milliseconds> timers(std::chrono::milliseconds(1000));
+
+        // nothing to pull
+        auto start = std::chrono::steady_clock::now();
+        assert(tsFIFO::select(20, control, data, timers)==-1);
+        assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+        // the first fifo with an item wins
+        int value = 1;
+        data.push(value);
+        std::unique_ptr<ITEM> item = std::make_unique<ITEM>(2);
+        timers.push(item);
+        unsigned timeout = 20;
+        assert(tsFIFO::select(timeout, control, data, timers)==1);
+        assert(tsFIFO::select(timeout, control, timers, data)==1);
+        item = std::make_unique<ITEM>(3);
+        control.push(item);
+        assert(tsFIFO::select(control, data, timers)==0);
+        control.pull(item);
+        data.pull(value);
+        assert(tsFIFO::select(0, control, data, timers)==2);
+        timers.pull(item);
+        assert(tsFIFO::select(0, control, data, timers)==-1);
+
+        // a push wakes a waiting select
+        std::thread pusher([&data](){
+            usleep(20000);
+            int value = 4;
+            data.push(value);
+        });
+        assert(tsFIFO::select(control, data, timers)==1);
+        pusher.join();
+        data.pull(value);
+        assert(value==4);
+
+        // a claimed slot is ready once committed
+        std::thread committer([&control](){
+            std::unique_ptr<ITEM>* slot = control.claim();
+            usleep(20000);
+            *slot = std::make_unique<ITEM>(5);
+            control.commit();
+        });
+        assert(tsFIFO::select(10000, data, control)==1);
+        committer.join();
+        control.pull(item);
+        assert(item->_value==5);
+
+        // the peeked item is not ready, the next one is after release()
+        item = std::make_unique<ITEM>(6);
+        control.push(item);
+        item = std::make_unique<ITEM>(7);
+        control.push(item);
+        std::atomic<bool> peeked(false);
+        std::thread releaser([&control, &peeked](){
+            control.peek();
+            peeked = true;
+            usleep(20000);
+            control.release();
+        });
+        while(!peeked)
+            usleep(100);
+        assert(tsFIFO::select(10000, control)==0);
+        releaser.join();
+        control.pull(item);
+        assert(item->_value==7);
+    }
+    {
+        // ===============================================
+        // C-style pointers
+        // ===============================================
+        smallFIFOC fifoc(2);
+        std::thread pusher([&fifoc](){
+            usleep(20000);
+            ITEM* item = new ITEM(8);
+            fifoc.push(item);
+        });
+        assert(tsFIFO::select(fifoc)==0);
+        pusher.join();
+        ITEM* item;
+        fifoc.pull(item);
+        assert(item->_value==8);
+        delete item;
+    }
+
+    // ===============================================
+	// Here instead we test if select is thread-safe
+    // ===============================================
+    std::array<std::thread,Nthreads> consumers;
+    std::array<std::thread,Nthreads> producers;
+    for(size_t i=0; i<Nthreads; ++i)
+        fifos[i].set_max_size(100);
+    for(size_t i=0; i<Nthreads; ++i){
+        consumers[i] = std::thread(consumer);
+        producers[i] = std::thread(producer,i);
+    }
+
+	for(size_t i=0; i<Nthreads; ++i){
+        consumers[i].join();
+        producers[i].join();
+    }
+
+    for(int i=0; i<Nthreads; ++i){
+        for(int j=0; j<Npushes; ++j){
+            // every item must be pulled exactly once
+#ifdef DEBUG
+            if(verif[i][j]!=1)
+                std::cout << "verif[" << i << "][" << j << "]=" << verif[i][j] << " Error\n";
+#endif
+            assert(verif[i][j]==1);
+        }
+    }
+
+    std::cout << "=======================================\n";
+    std::cout << "==========    Test passed!!   =========\n";
+    std::cout << "=======================================\n";
+
+	return 0;
+}
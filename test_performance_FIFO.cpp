@@ -21,6 +21,11 @@
 #include <utility>
 #include <thread>
 #include <atomic>
+#include <array>
+#include <vector>
+#include <numeric>
+#include <cmath>
+#include <functional>
 
 //#define DEBUG 1
 
@@ -140,6 +145,43 @@ double run_threads(size_t Nproducers, size_t Nconsumers){
     return Npushes*Nproducers/(execution_time);
 }
 
+// The same transfers with cooperative dispatch: the items are handed
+// to subscribers by a pool of threads, no consumer thread waits in pull()
+using TaskFIFO = tsFIFO::FIFO<std::function<void()>, tsFIFO::ActionIfFull::Nothing>;
+
+void run_subscribers_helper(size_t Nproducers, size_t Nsubscribers, size_t Nworkers){
+    TaskFIFO tasks(Nsubscribers + 1);
+    std::vector<std::thread> workers(Nworkers);
+    for(size_t i=0; i<Nworkers; ++i){
+        workers[i] = std::thread([&tasks](){
+            std::function<void()> task;
+            while(tasks.pull(task, 100) == tsFIFO::Status::SUCCESS) // 100ms timeout
+                task();
+        });
+    }
+    std::vector<std::shared_ptr<MyFIFO::Subscription>> subscriptions;
+    for(size_t i=0; i<Nsubscribers; ++i){
+        subscriptions.push_back(fifo.on_item([&tasks](std::function<void()> task){ tasks.push(task); },
+                                             [](std::vector<std::unique_ptr<ITEM>>& batch){}, 64));
+    }
+    std::vector<std::thread> threads_producers(Nproducers);
+    for(size_t i=0; i<Nproducers; ++i){
+        threads_producers[i] = std::thread(producer);
+    }
+    for(size_t i=0; i<Nproducers; ++i){
+        threads_producers[i].join();
+    }
+    for(size_t i=0; i<Nworkers; ++i){
+        workers[i].join();
+    }
+    subscriptions.clear();
+}
+
+double run_subscribers(size_t Nproducers, size_t Nsubscribers, size_t Nworkers){
+    double execution_time = measure<std::chrono::milliseconds>::run([&](){return run_subscribers_helper(Nproducers, Nsubscribers, Nworkers);});
+    return Npushes*Nproducers/(execution_time);
+}
+
 int main(int argc, char* argv[]){
     
     std::cout << "++++++ Testing FIFO ++++++" << "\n";
@@ -161,6 +203,23 @@ int main(int argc, char* argv[]){
         std::cout << "\n";
     }
     std::cout << "^^^^^^\nProducers\nthreads\n"; 
+
+    std::cout << "        --------------- Subscribers (on_item, batches of 64) on 2 worker threads ---------------" << "\n";
+    std::cout << "   ";
+    for(size_t j=1; j<9; ++j)
+        std::cout   << std::setw(12) << j;
+    std::cout << "\n";
+    for(size_t i=1; i<9; ++i){
+        std::cout   << "   " << i << "   ";
+        for(size_t j=1; j<9; ++j){
+            auto results = mean_stddev<5>::run([&](){return run_subscribers(i,j,2);});
+            std::cout   << std::setw(4) << static_cast<int>(results.first)
+                        << std::setw(6) << ("(+-" + std::to_string(static_cast<int>(results.second))) << ")"
+                        << " ";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "^^^^^^\nProducers\nthreads\n";
     
 	return 0;
 }
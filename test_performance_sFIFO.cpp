@@ -21,6 +21,10 @@
 #include <utility>
 #include <thread>
 #include <atomic>
+#include <array>
+#include <vector>
+#include <numeric>
+#include <cmath>
 
 //#define DEBUG 1
 